@@ -55,22 +55,28 @@ namespace bspline::examples::diffusion {
         auto last = std::move(basis.back());
         last *= endValue;
         basis.erase(basis.begin());
-        basis.erase(basis.end());
+        basis.pop_back();
 
         const integration::BilinearForm bilinearForm{
                 (static_cast<data_t>(1) / 2) *
                 (Dx<1>{} * SplineOperator{std::move(diffusionCoeff)} * Dx<1>{})};
 
-        DeVec b = DeVec::Zero(basis.size());
-        const integration::ScalarProduct sp{};
+        // The basis is transformed once for the right hand side and the matrix.
+        const auto transformedBasis = bilinearForm.transform(basis);
+        const auto transformedBoundary =
+                bilinearForm.transform(std::vector<Spline>{first, last});
+
+        std::vector<data_t> b(basis.size());
         for (size_t i = 0; i < basis.size(); i++) {
-            b(i) = -(bilinearForm.evaluate(basis.at(i), first) +
-                     bilinearForm.evaluate(basis.at(i), last));
+            b[i] = -(bilinearForm.evaluate(transformedBasis, i, transformedBoundary, 0) +
+                     bilinearForm.evaluate(transformedBasis, i, transformedBoundary, 1));
         }
 
-        const DeMat mat = setUpSymmetricMatrix(bilinearForm, basis);
-
-        const auto coeffs = toStdVector(mat.colPivHouseholderQr().solve(b));
+        // The matrix is symmetric and negative definite, hence an LDL^T
+        // factorization without pivoting is stable.
+        BandedSymmetricMatrix<data_t> mat(bilinearForm.assemble(transformedBasis));
+        mat.factorizeLDLT();
+        const std::vector<data_t> coeffs = mat.solve(std::move(b));
 
         return linearCombination(coeffs, basis) + first + last;
     }
@@ -50,7 +50,8 @@ namespace bspline::examples {
 
     /**
  * @brief setUpSymmetricMatrix Sets up a symmetric matrix, where the matrix
- * elements are defined by the bilinear form.
+ * elements are defined by the bilinear form. Only the elements of overlapping
+ * basis functions are evaluated, the upper triangle being mirrored.
  * @param b The BilinearForm.
  * @param basis The basis functions (i.e. BSplines).
  * @tparam B The type of the bilinear form.
@@ -58,12 +59,14 @@ namespace bspline::examples {
  */
     template<typename B>
     DeMat setUpSymmetricMatrix(const B &b, const std::vector<Spline> &basis) {
+        const SparseMatrix<data_t> sparse = b.assemble(basis);
         DeMat ret = DeMat::Zero(basis.size(), basis.size());
-        for (size_t i = 0; i < basis.size(); i++) {
-            for (size_t j = i; j < basis.size(); j++) {
-                const data_t val = b.evaluate(basis.at(i), basis.at(j));
-                ret(i, j) = val;
-                ret(j, i) = val;
+        for (size_t i = 0; i < sparse.rows; i++) {
+            for (size_t k = sparse.rowOffsets[i]; k < sparse.rowOffsets[i + 1]; k++) {
+                const size_t j = sparse.columnIndices[k];
+                if (j < i) continue;
+                ret(i, j) = sparse.values[k];
+                ret(j, i) = sparse.values[k];
             }
         }
         return ret;
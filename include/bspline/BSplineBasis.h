@@ -0,0 +1,269 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_BSPLINEBASIS_H
+#define BSPLINE_BSPLINEBASIS_H
+
+#include <bspline/Spline.h>
+#include <bspline/SplineView.h>
+#include <bspline/exceptions/BSplineException.h>
+#include <bspline/internal/IndexIterator.h>
+#include <bspline/internal/StableGrid.h>
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace bspline {
+    using namespace bspline::exceptions;
+
+    /*!
+ * Stores a set of splines defined on the same grid, e.g. the BSplines returned
+ * by BSplineGenerator::generateBasis(), in a single block of coefficients. The
+ * coefficients of the i-th spline follow those of the (i - 1)-th spline, only
+ * the index range of the support is stored per spline. The splines are accessed
+ * as SplineView objects, such that the basis can be passed wherever a
+ * collection of splines is expected. The block of coefficients may be
+ * allocated from a std::pmr::memory_resource, e.g. an arena; moving a basis
+ * keeps the block and its resource, copies of a basis use the default resource.
+ *
+ * @tparam T Datatype of the splines.
+ * @tparam order Order of the splines.
+ */
+    template<typename T, size_t order>
+    class BSplineBasis final {
+    private:
+        /*! Number of coefficients per interval. */
+        static constexpr size_t ARRAY_SIZE = order + 1;
+
+        /*! The global grid, kept at a fixed address such that moves keep views valid. */
+        internal::StableGrid<T> _grid;
+        /*! The index of the first grid point of the support of each spline. */
+        std::vector<size_t> _startIndices;
+        /*! The index behind the last grid point of the support of each spline. */
+        std::vector<size_t> _endIndices;
+        /*!
+   * The coefficients of the i-th spline begin at _coefficients[_offsets[i]]. Has
+   * size() + 1 elements.
+   */
+        std::vector<size_t> _offsets;
+        /*! The coefficients of all splines. */
+        std::pmr::vector<std::array<T, ARRAY_SIZE>> _coefficients;
+
+        /*!
+   * Returns the grid of the first spline of a range.
+   *
+   * @param splinesBegin The iterator referencing the first spline.
+   * @param splinesEnd The iterator referencing the end of the splines.
+   * @throws BSplineException If the range of splines is empty.
+   * @returns The grid of the first spline.
+   */
+        template<typename SplineIter>
+        static Grid<T> getFirstGrid(SplineIter splinesBegin, SplineIter splinesEnd) {
+            if (splinesBegin == splinesEnd) {
+                throw BSplineException(ErrorCode::MISSING_DATA,
+                                       "The number of splines may not be zero.");
+            }
+            return splinesBegin->getSupport().getGrid();
+        }
+
+    public:
+        /*!
+   * The type of the elements of the basis.
+   */
+        using value_type = SplineView<T, order>;
+
+        /*!
+   * Random access iterator referencing the splines of a basis. Dereferencing
+   * yields a SplineView by value.
+   */
+        using const_iterator = internal::IndexIterator<BSplineBasis>;
+
+        /*!
+   * Provides acces to the data type T of the splines.
+   */
+        using data_type = T;
+
+        /*!
+   * Provides access to the order of the splines.
+   */
+        static constexpr size_t spline_order = order;
+
+        /*!
+   * Copies a range of splines into a basis.
+   *
+   * @param splinesBegin The iterator referencing the first spline.
+   * @param splinesEnd The iterator referencing the end of the splines.
+   * @param resource The memory resource the coefficients are allocated from.
+   * Must outlive the basis.
+   * @tparam SplineIter An iterator referencing a spline of type
+   * Spline<T, order> or SplineView<T, order>.
+   * @throws BSplineException If the range of splines is empty or the splines
+   * are defined on different grids.
+   */
+        template<typename SplineIter>
+        BSplineBasis(SplineIter splinesBegin, SplineIter splinesEnd,
+                     std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+                : _grid(getFirstGrid(splinesBegin, splinesEnd)), _offsets{0},
+                  _coefficients(resource) {
+            size_t nIntervals = 0;
+            for (auto it = splinesBegin; it != splinesEnd; it++) {
+                if (it->getSupport().getGrid() != _grid.get()) {
+                    throw BSplineException(ErrorCode::DIFFERING_GRIDS);
+                }
+                nIntervals += it->getSupport().numberOfIntervals();
+            }
+            _coefficients.reserve(nIntervals);
+
+            for (auto it = splinesBegin; it != splinesEnd; it++) {
+                const auto &spline = *it;
+                const Support<T> &support = spline.getSupport();
+                _startIndices.push_back(support.getStartIndex());
+                _endIndices.push_back(support.getEndIndex());
+                if (support.containsIntervals()) {
+                    const auto *coefficients = &spline.getCoefficients()[0];
+                    _coefficients.insert(_coefficients.end(), coefficients,
+                                         coefficients + support.numberOfIntervals());
+                }
+                _offsets.push_back(_coefficients.size());
+            }
+        }
+
+        /*!
+   * Copies a collection of splines into a basis.
+   *
+   * @param splines The splines. Must provide begin() and end() iterators.
+   * @param resource The memory resource the coefficients are allocated from.
+   * Must outlive the basis.
+   * @tparam SplineCollection A collection of splines of type Spline<T, order>
+   * or SplineView<T, order>.
+   * @throws BSplineException If the collection is empty or the splines are
+   * defined on different grids.
+   */
+        template<typename SplineCollection>
+        explicit BSplineBasis(
+                const SplineCollection &splines,
+                std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+                : BSplineBasis(splines.begin(), splines.end(), resource) {}
+
+        /*!
+   * Constructs a basis from the supports and the block of coefficients of its
+   * splines, see getCoefficients().
+   *
+   * @param grid The global grid.
+   * @param startIndices The index of the first grid point of the support of
+   * each spline.
+   * @param endIndices The index behind the last grid point of the support of
+   * each spline.
+   * @param coefficients The coefficients of all splines. Its memory resource
+   * is kept.
+   * @throws BSplineException If there are no splines, the supports are
+   * invalid or the number of coefficients does not match the supports.
+   */
+        BSplineBasis(const Grid<T> &grid, std::vector<size_t> startIndices,
+                     std::vector<size_t> endIndices,
+                     std::pmr::vector<std::array<T, ARRAY_SIZE>> coefficients)
+                : _grid(grid), _startIndices(std::move(startIndices)),
+                  _endIndices(std::move(endIndices)), _offsets{0},
+                  _coefficients(std::move(coefficients)) {
+            if (_startIndices.empty()) {
+                throw BSplineException(ErrorCode::MISSING_DATA,
+                                       "The number of splines may not be zero.");
+            } else if (_startIndices.size() != _endIndices.size()) {
+                throw BSplineException(ErrorCode::INCONSISTENT_DATA);
+            }
+            for (size_t i = 0; i < _startIndices.size(); i++) {
+                const Support<T> support(_grid.get(), _startIndices[i], _endIndices[i]);
+                _offsets.push_back(_offsets.back() + support.numberOfIntervals());
+            }
+            if (_offsets.back() != _coefficients.size()) {
+                throw BSplineException(ErrorCode::INCONSISTENT_DATA);
+            }
+        }
+
+        /*!
+   * Returns the global grid.
+   */
+        const Grid<T> &getGrid() const noexcept { return _grid.get(); };
+
+        /*!
+   * Returns the number of splines.
+   */
+        size_t size() const noexcept { return _startIndices.size(); };
+
+        /*!
+   * Returns the coefficients of all splines, in the order of the splines.
+   */
+        const std::pmr::vector<std::array<T, ARRAY_SIZE>> &getCoefficients() const noexcept {
+            return _coefficients;
+        };
+
+        /*!
+   * Returns a view of the i-th spline.
+   *
+   * @param i The index of the spline. Must be smaller than size().
+   * @returns The view of the spline, which refers to the grid and the
+   * coefficients stored in this basis. It stays valid if the basis is moved
+   * and is invalidated if the basis is destroyed or assigned to.
+   */
+        SplineView<T, order> operator[](size_t i) const {
+            return SplineView<T, order>(_grid.get(), _startIndices[i], _endIndices[i],
+                                        _coefficients.data() + _offsets[i]);
+        };
+
+        /*!
+   * Returns a view of the i-th spline.
+   *
+   * @param i The index of the spline.
+   * @throws BSplineException If i is not smaller than size().
+   * @returns The view of the spline.
+   */
+        SplineView<T, order> at(size_t i) const {
+            if (i >= size()) {
+                throw BSplineException(ErrorCode::INVALID_ACCESS);
+            }
+            return (*this)[i];
+        };
+
+        /*!
+   * Returns the iterator referencing the first spline.
+   */
+        const_iterator begin() const { return const_iterator(this, 0); };
+
+        /*!
+   * Returns the iterator referencing the end of the splines.
+   */
+        const_iterator end() const {
+            return const_iterator(this, static_cast<std::ptrdiff_t>(size()));
+        };
+
+        /*!
+   * Copies the splines out of the basis.
+   *
+   * @returns The splines.
+   */
+        std::vector<Spline<T, order>> toSplines() const {
+            std::vector<Spline<T, order>> ret;
+            ret.reserve(size());
+            for (size_t i = 0; i < size(); i++) {
+                ret.push_back((*this)[i].toSpline());
+            }
+            return ret;
+        }
+    };
+
+    /*!
+ * Deduction guide for a basis constructed from a collection of splines.
+ */
+    template<typename SplineCollection>
+    BSplineBasis(const SplineCollection &splines) -> BSplineBasis<
+            typename SplineCollection::value_type::data_type,
+            SplineCollection::value_type::spline_order>;
+
+}// namespace bspline
+#endif// BSPLINE_BSPLINEBASIS_H
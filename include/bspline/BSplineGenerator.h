@@ -10,6 +10,8 @@
 #ifndef BSPLINE_BSPLINEGENERATOR_H
 #define BSPLINE_BSPLINEGENERATOR_H
 
+#include <bspline/BSplineBasis.h>
+#include <bspline/ParallelEvaluator.h>
 #include <bspline/Spline.h>
 #include <bspline/exceptions/BSplineException.h>
 #include <bspline/operators/CompoundOperators.h>
@@ -17,6 +19,11 @@
 #include <bspline/operators/ScalarOperators.h>
 
 #include <algorithm>
+#include <array>
+#include <functional>
+#include <memory_resource>
+#include <utility>
+#include <vector>
 
 namespace bspline {
     using namespace bspline::exceptions;
@@ -87,85 +94,244 @@ namespace bspline {
         Grid<T> getGrid() const { return _grid; };
 
         /*!
-   * Generates all BSplines with respect to the knots vector.
+   * Returns the knots.
+   */
+        const std::vector<T> &getKnots() const { return _knots; };
+
+        /*!
+   * Generates all BSplines with respect to the knots vector. The polynomial
+   * coefficients of each interval are computed directly from the knots by the
+   * recursion relation \f[B_{i,k}(x) = \frac{x - x_i}{x_{i + k -1} - x_i}\ B_{i,
+   * k-1}(x) + \frac{x_{i+k}-x}{x_{i+k}-x_{i+1}}\,B_{i+1,k-1}(x)\f], one order
+   * at a time, without constructing the lower order splines. The arithmetic is
+   * the one of the operators
+   * \f$\frac{1}{x_{i + k -1} - x_i}(X - x_i)\f$ and
+   * \f$\frac{1}{x_{i+k}-x_{i+1}}(x_{i+k} - X)\f$ applied to the lower order
+   * splines, hence the results coincide with those of these operators.
+   *
    * @tparam order Order of the BSplines to generate.
    * @throws BSplineException If the knots vector does not contain enough
    * entries to generate a spline of the requested order.
+   * @throws BSplineException If the knots are not in increasing order.
    * @returns All BSplines of order order defined on the knots vector.
    */
         template<size_t order>
         std::vector<Spline<T, order>> generateBSplines() const {
-            static constexpr size_t k = order + 1;
-            if (_knots.size() < k) {
-                throw BSplineException(ErrorCode::UNDETERMINED,
-                                       "The knots vector contains too few elements to "
-                                       "generate BSplines of the requested order.");
+            return generateBSplines<order>(
+                    1, [](size_t nTasks, const std::function<void(size_t)> &task) {
+                        for (size_t c = 0; c < nTasks; c++) task(c);
+                    });
+        }
+
+        /*!
+   * Generates all BSplines with respect to the knots vector, the coefficients
+   * of each order being computed in parallel. The splines of each order are
+   * split into nChunks contiguous chunks, which are processed by independent
+   * tasks. Each coefficient is computed by the same operations as by
+   * generateBSplines(), hence the results are identical for any number of
+   * chunks and any execution order of the tasks. All memory is allocated by
+   * the calling thread. See generateBSplines(ParallelEvaluator &) for a variant using a pool of
+   * threads.
+   *
+   * @param nChunks The number of chunks the splines of each order are split
+   * into.
+   * @param parallelFor Callable executing task(c) for all c in [0, nTasks)
+   * and returning once all tasks are finished, when called as
+   * parallelFor(nTasks, task).
+   * @tparam order Order of the BSplines to generate.
+   * @tparam ParallelFor The type of the callable.
+   * @throws BSplineException If the knots vector does not contain enough
+   * entries to generate a spline of the requested order.
+   * @throws BSplineException If the knots are not in increasing order.
+   * @returns All BSplines of order order defined on the knots vector.
+   */
+        template<size_t order, typename ParallelFor>
+        std::vector<Spline<T, order>> generateBSplines(size_t nChunks,
+                                                       const ParallelFor &parallelFor) const {
+            const BSplineLevel<order> level = generateLevel<order>(
+                    nChunks, parallelFor, std::pmr::get_default_resource());
+
+            const size_t numberOfSplines = level.first.size();
+            std::vector<Spline<T, order>> ret;
+            ret.reserve(numberOfSplines);
+            for (size_t i = 0; i < numberOfSplines; i++) {
+                if (level.first[i] == level.last[i]) {
+                    ret.push_back(Spline<T, order>{_grid});
+                } else {
+                    typename Spline<T, order>::coefficients_type coefficients(
+                            level.coefficients.begin() + level.offsets[i],
+                            level.coefficients.begin() + level.offsets[i + 1]);
+                    ret.push_back(Spline<T, order>{
+                            Support(_grid, level.first[i], level.last[i] + 1),
+                            std::move(coefficients)});
+                }
             }
+            return ret;
+        }
+
+        /*!
+   * Generates all BSplines with respect to the knots vector on the threads of
+   * an evaluator, see generateBSplines(size_t, const ParallelFor &). The
+   * results are identical to those of generateBSplines(), independent of the
+   * number of threads.
+   *
+   * @param evaluator The evaluator providing the threads.
+   * @tparam order Order of the BSplines to generate.
+   * @throws BSplineException If the knots vector does not contain enough
+   * entries to generate a spline of the requested order.
+   * @throws BSplineException If the knots are not in increasing order.
+   * @returns All BSplines of order order defined on the knots vector.
+   */
+        template<size_t order>
+        std::vector<Spline<T, order>> generateBSplines(ParallelEvaluator &evaluator) const {
+            // Each spline costs about as much as the evaluation of one point per
+            // interval of its support.
+            const size_t nIntervals = _knots.size() * (order + 1);
+            return generateBSplines<order>(
+                    evaluator.numberOfChunks(nIntervals),
+                    [&evaluator](size_t nTasks, const std::function<void(size_t)> &task) {
+                        evaluator.parallelFor(nTasks, task);
+                    });
+        }
+
+        /*!
+   * Generates all BSplines with respect to the knots vector and stores them in
+   * a single block of coefficients.
+   * @tparam order Order of the BSplines to generate.
+   * @throws BSplineException If the knots vector does not contain enough
+   * entries to generate at least one spline of the requested order.
+   * @returns The basis of all BSplines of order order defined on the knots
+   * vector.
+   */
+        template<size_t order>
+        BSplineBasis<T, order> generateBasis() const {
+            return generateBasis<order>(std::pmr::get_default_resource());
+        }
 
-            if constexpr (order == 0) {
-                return generateZerothOrderSplines();
-            } else {
-                const auto nextLowerOrderSplines = generateBSplines<order - 1>();
-                std::vector<Spline<T, order>> ret;
-                ret.reserve(_knots.size() - k);
-                for (size_t i = 0; i < _knots.size() - k; i++) {
-                    ret.push_back(applyRecursionRelation<k>(
-                            i, nextLowerOrderSplines.at(i), nextLowerOrderSplines.at(i + 1)));
+        /*!
+   * Generates all BSplines with respect to the knots vector and stores them in
+   * a single block of coefficients allocated from a memory resource, e.g. a
+   * std::pmr::monotonic_buffer_resource. The coefficients of the intermediate
+   * lower orders are allocated from the resource as well, such that the whole
+   * generation can be released at once. Moving the returned basis keeps the
+   * resource.
+   *
+   * @param resource The memory resource. Must outlive the basis.
+   * @tparam order Order of the BSplines to generate.
+   * @throws BSplineException If the knots vector does not contain enough
+   * entries to generate at least one spline of the requested order.
+   * @returns The basis of all BSplines of order order defined on the knots
+   * vector.
+   */
+        template<size_t order>
+        BSplineBasis<T, order> generateBasis(std::pmr::memory_resource *resource) const {
+            BSplineLevel<order> level = generateLevel<order>(
+                    1,
+                    [](size_t nTasks, const std::function<void(size_t)> &task) {
+                        for (size_t c = 0; c < nTasks; c++) task(c);
+                    },
+                    resource);
+
+            const size_t numberOfSplines = level.first.size();
+            std::vector<size_t> startIndices(numberOfSplines, 0);
+            std::vector<size_t> endIndices(numberOfSplines, 0);
+            for (size_t i = 0; i < numberOfSplines; i++) {
+                if (level.first[i] != level.last[i]) {
+                    startIndices[i] = level.first[i];
+                    endIndices[i] = level.last[i] + 1;
                 }
-                return ret;
             }
+            level.coefficients.resize(level.offsets.back());
+            return BSplineBasis<T, order>(_grid, std::move(startIndices), std::move(endIndices),
+                                          std::move(level.coefficients));
         }
 
     private:
         /*!
-   * Generates a Bspline of order k-1 at knot i by application of the recursion
-   * relation \f[B_{i,k}(x) = \frac{x - x_i}{x_{i + k -1} - x_i}\ B_{i, k-1}(x)
-   * + \frac{x_{i+k}-x}{x_{i+k}-x_{i+1}}\,B_{i+1,k-1}(x)\f].
+   * The BSplines of one order j <= maxOrder, stored contiguously. The i-th
+   * spline is supported on the grid intervals [first[i], last[i]), its
+   * coefficients are located at the indices [offsets[i], offsets[i + 1]) of
+   * coefficients. Only the first j + 1 entries of each array are used.
    *
-   * @param i Index of the knot at which to generate the BSpline.
-   * @param splinei The spline of the next lower order at index i.
-   * @param splineip1 The spline of the next lower order at index i + 1.
-   * @tparam k Number of the coefficients per interval for the spline (i.e.
-   * order of the spline plus one).
-   * @returns The BSpline of next higher order, derived from the two lower order
-   * splines via the recursion relation.
+   * @tparam maxOrder The order of the BSplines finally generated.
    */
-        template<size_t k>
-        Spline<T, k - 1> applyRecursionRelation(
-                size_t i, const Spline<T, k - 2> &splinei,
-                const Spline<T, k - 2> &splineip1) const {
-            static_assert(k >= 2, "k has to be at least 2.");
-
-            Spline<T, k - 1> ret(_grid);
-
-            const T &xi = _knots.at(i);
-            const T &xipkm1 = _knots.at(i + k - 1);
-            if (xipkm1 > xi) {
-                const T prefac = static_cast<T>(1) / (xipkm1 - xi);
-                const auto op = prefac * (operators::X<1>{} - xi);
-                ret = op * splinei;
-            }
+        template<size_t maxOrder>
+        struct BSplineLevel {
+            /*! The index of the first grid interval of each support. */
+            std::pmr::vector<size_t> first;
+            /*! The index behind the last grid interval of each support. */
+            std::pmr::vector<size_t> last;
+            /*! The offsets of the coefficients of each spline. */
+            std::pmr::vector<size_t> offsets;
+            /*! The coefficients of all splines. */
+            std::pmr::vector<std::array<T, maxOrder + 1>> coefficients;
 
-            const T &xip1 = _knots.at(i + 1);
-            const T &xipk = _knots.at(i + k);
-            if (xipk > xip1) {
-                const T prefac = static_cast<T>(1) / (xipk - xip1);
-                const auto op = prefac * (xipk - operators::X<1>{});
-                ret += op * splineip1;
+            /*!
+     * Constructs an empty set of BSplines.
+     *
+     * @param resource The memory resource the data is allocated from.
+     */
+            explicit BSplineLevel(std::pmr::memory_resource *resource)
+                    : first(resource), last(resource), offsets(resource), coefficients(resource) {}
+        };
+
+        /*!
+   * Generates all BSplines of order order, see
+   * generateBSplines(size_t, const ParallelFor &).
+   *
+   * @param nChunks The number of chunks the splines of each order are split
+   * into.
+   * @param parallelFor Callable executing task(c) for all c in [0, nTasks)
+   * when called as parallelFor(nTasks, task).
+   * @param resource The memory resource all data is allocated from.
+   * @tparam order Order of the BSplines to generate.
+   * @throws BSplineException If the knots vector does not contain enough
+   * entries to generate a spline of the requested order.
+   * @throws BSplineException If the knots are not in increasing order.
+   * @returns The BSplines of order order. The coefficients may have room for
+   * more than offsets.back() intervals.
+   */
+        template<size_t order, typename ParallelFor>
+        BSplineLevel<order> generateLevel(size_t nChunks, const ParallelFor &parallelFor,
+                                          std::pmr::memory_resource *resource) const {
+            static constexpr size_t k = order + 1;
+            if (_knots.size() < k) {
+                throw BSplineException(ErrorCode::UNDETERMINED,
+                                       "The knots vector contains too few elements to "
+                                       "generate BSplines of the requested order.");
             }
 
-            return ret;
+            // The levels are computed alternately into two buffers, which are
+            // allocated once with room for the coefficients of every order.
+            BSplineLevel<order> level = generateZerothOrderLevel<order>(resource);
+            BSplineLevel<order> buffer(resource);
+            const size_t maxIntervals = level.first.size() * k;
+            level.coefficients.resize(maxIntervals);
+            buffer.coefficients.resize(maxIntervals);
+            generateLevels<order, 1>(level, buffer, nChunks, parallelFor);
+            return level;
         }
 
         /*!
    * Generates all zeroth order BSplines.
    *
+   * @param resource The memory resource all data is allocated from.
+   * @tparam maxOrder The order of the BSplines finally generated.
+   * @throws BSplineException If the knots are not in increasing order.
    * @returns The zeroth order BSplines defined on the knots vector.
    */
-        std::vector<Spline<T, 0>> generateZerothOrderSplines() const {
-            std::vector<Spline<T, 0>> ret;
+        template<size_t maxOrder>
+        BSplineLevel<maxOrder> generateZerothOrderLevel(std::pmr::memory_resource *resource) const {
             const size_t numberOfSplines = (_knots.empty()) ? 0 : _knots.size() - 1;
-            ret.reserve(numberOfSplines);
+
+            BSplineLevel<maxOrder> ret(resource);
+            ret.first.reserve(numberOfSplines);
+            ret.last.reserve(numberOfSplines);
+            ret.offsets.reserve(numberOfSplines + 1);
+            ret.offsets.push_back(0);
+
+            auto one = internal::make_array<T, maxOrder + 1>(static_cast<T>(0));
+            one[0] = static_cast<T>(1);
 
             for (size_t i = 0; i < numberOfSplines; i++) {
                 const T &xi = _knots.at(i);
@@ -174,18 +340,150 @@ namespace bspline {
                 if (xi > xip1) {
                     throw BSplineException(ErrorCode::UNDETERMINED);
                 } else if (xi == xip1) {
-                    ret.push_back(Spline<T, 0>{_grid});
+                    ret.first.push_back(0);
+                    ret.last.push_back(0);
                 } else {
-                    std::vector<std::array<T, 1>> coefficients{{static_cast<T>(1)}};
-
                     const size_t gridIndex = _grid.findElement(xi);
-
-                    ret.push_back(Spline<T, 0>{Support(_grid, gridIndex, gridIndex + 2),
-                                               std::move(coefficients)});
+                    ret.first.push_back(gridIndex);
+                    ret.last.push_back(gridIndex + 1);
+                    ret.coefficients.push_back(one);
                 }
+                ret.offsets.push_back(ret.coefficients.size());
             }
             return ret;
         }
+
+        /*!
+   * Generates the BSplines of the orders j to maxOrder from those of order
+   * j - 1 by repeated application of the recursion relation. The coefficients
+   * of each interval are computed as by the operators of the recursion relation
+   * applied to the lower order splines, with the sum of both terms evaluated as
+   * by Spline::operator+=().
+   *
+   * @param level The BSplines of order j - 1, replaced by those of order
+   * maxOrder.
+   * @param buffer Storage for the intermediate orders. Its coefficients must
+   * have the same size as those of level.
+   * @param nChunks The number of chunks the splines are split into.
+   * @param parallelFor Callable executing task(c) for all c in [0, nTasks)
+   * when called as parallelFor(nTasks, task).
+   * @tparam maxOrder The order of the BSplines finally generated.
+   * @tparam j The lowest order of the BSplines to generate.
+   */
+        template<size_t maxOrder, size_t j, typename ParallelFor>
+        void generateLevels(BSplineLevel<maxOrder> &level, BSplineLevel<maxOrder> &buffer,
+                            size_t nChunks, const ParallelFor &parallelFor) const {
+            if constexpr (j <= maxOrder) {
+                generateNextLevel<maxOrder, j>(level, buffer, nChunks, parallelFor);
+                std::swap(level, buffer);
+                generateLevels<maxOrder, j + 1>(level, buffer, nChunks, parallelFor);
+            }
+        }
+
+        /*!
+   * Generates the BSplines of order j from those of order j - 1. See
+   * generateLevels().
+   *
+   * @param lower The BSplines of order j - 1.
+   * @param ret Receives the BSplines of order j. Every coefficient used by them
+   * is overwritten, the coefficients must have room for all their intervals.
+   * @param nChunks The number of chunks the splines are split into.
+   * @param parallelFor Callable executing task(c) for all c in [0, nTasks)
+   * when called as parallelFor(nTasks, task).
+   * @tparam maxOrder The order of the BSplines finally generated.
+   * @tparam j The order of the BSplines to generate.
+   */
+        template<size_t maxOrder, size_t j, typename ParallelFor>
+        void generateNextLevel(const BSplineLevel<maxOrder> &lower, BSplineLevel<maxOrder> &ret,
+                               size_t nChunks, const ParallelFor &parallelFor) const {
+            const size_t numberOfSplines = lower.first.size() - 1;
+            const auto contains = [&lower](size_t i, size_t g) {
+                return lower.first[i] <= g && g < lower.last[i];
+            };
+
+            ret.first.resize(numberOfSplines);
+            ret.last.resize(numberOfSplines);
+            ret.offsets.clear();
+            ret.offsets.push_back(0);
+
+            // The supports are the union of the supports of the contributing lower
+            // order splines.
+            for (size_t i = 0; i < numberOfSplines; i++) {
+                const bool useFirst = _knots[i + j] > _knots[i] && lower.first[i] != lower.last[i];
+                const bool useSecond = _knots[i + j + 1] > _knots[i + 1] &&
+                                       lower.first[i + 1] != lower.last[i + 1];
+                if (useFirst && useSecond) {
+                    ret.first[i] = std::min(lower.first[i], lower.first[i + 1]);
+                    ret.last[i] = std::max(lower.last[i], lower.last[i + 1]);
+                } else if (useFirst || useSecond) {
+                    ret.first[i] = lower.first[useFirst ? i : i + 1];
+                    ret.last[i] = lower.last[useFirst ? i : i + 1];
+                } else {
+                    ret.first[i] = ret.last[i] = 0;
+                }
+                ret.offsets.push_back(ret.offsets.back() + (ret.last[i] - ret.first[i]));
+            }
+
+            // Coefficients of (X - xm) p(X - xm) on interval g, where p has order
+            // j - 1, as computed by the position operator.
+            const auto multiplyByX = [](const std::array<T, maxOrder + 1> &c, const T &xm,
+                                        size_t q) {
+                T r = static_cast<T>(0);
+                if (q > 0) r += c[q - 1];
+                if (q < j) r += xm * c[q];
+                return r;
+            };
+
+            // The midpoints of all intervals, stored contiguously by the grid.
+            const T *midpoints = &_grid.midpoint(0);
+
+            // The splines of a chunk only write to their own coefficients.
+            nChunks = std::max<size_t>(std::min(nChunks, numberOfSplines), 1);
+            const auto chunkBegin = [&](size_t c) { return numberOfSplines * c / nChunks; };
+
+            parallelFor(nChunks, [&](size_t chunk) {
+                for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+                    const T &xi = _knots[i];
+                    const T &xipkm1 = _knots[i + j];
+                    const T &xip1 = _knots[i + 1];
+                    const T &xipk = _knots[i + j + 1];
+                    const T prefacFirst =
+                            xipkm1 > xi ? static_cast<T>(1) / (xipkm1 - xi) : static_cast<T>(0);
+                    const T prefacSecond =
+                            xipk > xip1 ? static_cast<T>(1) / (xipk - xip1) : static_cast<T>(0);
+
+                    for (size_t g = ret.first[i]; g < ret.last[i]; g++) {
+                        const T &xm = midpoints[g];
+                        auto &coeffs = ret.coefficients[ret.offsets[i] + g - ret.first[i]];
+                        const bool inFirst = xipkm1 > xi && contains(i, g);
+                        const bool inSecond = xipk > xip1 && contains(i + 1, g);
+
+                        if (inFirst) {
+                            const auto &c = lower.coefficients[lower.offsets[i] + g - lower.first[i]];
+                            for (size_t q = 0; q <= j; q++) {
+                                T r = multiplyByX(c, xm, q);
+                                if (q < j) r -= c[q] * xi;
+                                coeffs[q] = r * prefacFirst;
+                            }
+                        }
+                        if (inSecond) {
+                            const auto &c =
+                                    lower.coefficients[lower.offsets[i + 1] + g - lower.first[i + 1]];
+                            for (size_t q = 0; q <= j; q++) {
+                                const T r = multiplyByX(c, xm, q);
+                                const T term = (q < j ? c[q] * xipk - r : -r) * prefacSecond;
+                                coeffs[q] = inFirst ? coeffs[q] + term : term;
+                            }
+                        } else if (!inFirst) {
+                            // Gap between the supports of the lower order splines.
+                            for (size_t q = 0; q <= j; q++) {
+                                coeffs[q] = static_cast<T>(0);
+                            }
+                        }
+                    }
+                }
+            });
+        }
     };
 
     /*!
@@ -205,5 +503,45 @@ namespace bspline {
         return gen.template generateBSplines<order>();
     }
 
+    /*!
+ * Convenience method to generate the basis of BSplines on a knots vector.
+ *
+ * @param knots The knots vector to generate the splines from.
+ * @tparam order The order of the BSplines to generate.
+ * @tparam T The data type of the knots vector and the generated BSplines.
+ * @throws BSplineException If the knots vector does not contain enough entries
+ * to generate at least one spline of the requested order.
+ * @throws BSplineException If the knots are not in increasing order.
+ * @returns The basis of all BSplines of order order defined on the knots
+ * vector.
+ */
+    template<size_t order, typename T>
+    BSplineBasis<T, order> generateBasis(std::vector<T> knots) {
+        BSplineGenerator gen(std::move(knots));
+        return gen.template generateBasis<order>();
+    }
+
+    /*!
+ * Convenience method to generate the basis of BSplines on a knots vector, the
+ * coefficients being allocated from a memory resource. See
+ * BSplineGenerator::generateBasis(std::pmr::memory_resource *).
+ *
+ * @param knots The knots vector to generate the splines from.
+ * @param resource The memory resource. Must outlive the basis.
+ * @tparam order The order of the BSplines to generate.
+ * @tparam T The data type of the knots vector and the generated BSplines.
+ * @throws BSplineException If the knots vector does not contain enough entries
+ * to generate at least one spline of the requested order.
+ * @throws BSplineException If the knots are not in increasing order.
+ * @returns The basis of all BSplines of order order defined on the knots
+ * vector.
+ */
+    template<size_t order, typename T>
+    BSplineBasis<T, order> generateBasis(std::vector<T> knots,
+                                         std::pmr::memory_resource *resource) {
+        BSplineGenerator gen(std::move(knots));
+        return gen.template generateBasis<order>(resource);
+    }
+
 }// namespace bspline
 #endif// BSPLINE_BSPLINEGENERATOR_H
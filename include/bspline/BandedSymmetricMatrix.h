@@ -0,0 +1,364 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_BANDEDSYMMETRICMATRIX_H
+#define BSPLINE_BANDEDSYMMETRICMATRIX_H
+
+#include <bspline/SparseMatrix.h>
+#include <bspline/exceptions/BSplineException.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace bspline {
+    using namespace bspline::exceptions;
+
+    /*!
+ * Symmetric matrix whose nonzero elements lie within a band of bandwidth kd
+ * around the diagonal, e.g. the matrix of a symmetric bilinear form over a
+ * basis of BSplines of order kd. Only the diagonal and the kd subdiagonals
+ * are stored, in the band storage of LAPACK for the lower triangle: element
+ * (i, j) with j <= i <= j + kd is located at index (i - j) + j * (kd + 1).
+ *
+ * The matrix can be factorized in place by a Cholesky (positive definite
+ * matrices) or an LDL^T (nonsingular matrices, without pivoting)
+ * factorization, after which linear systems can be solved in O(n kd) time. No
+ * external linear algebra library is needed, hence any data type T providing
+ * the arithmetic operations and sqrt() can be used.
+ *
+ * @tparam T Datatype of the elements.
+ */
+    template<typename T>
+    class BandedSymmetricMatrix final {
+    public:
+        /*!
+   * The state of the stored elements.
+   */
+        enum class Factorization {
+            /*! The elements of the matrix. */
+            NONE,
+            /*! The lower triangular factor L of A = L L^T. */
+            CHOLESKY,
+            /*!
+     * The unit lower triangular factor L of A = L D L^T, D being stored on the
+     * diagonal.
+     */
+            LDLT,
+            /*!
+     * A factorization failed after overwriting part of the elements. The
+     * matrix is unusable, all methods accessing the elements with checks throw.
+     */
+            FAILED
+        };
+
+    private:
+        /*! The number of rows and columns. */
+        size_t _size;
+        /*! The number of stored subdiagonals. */
+        size_t _bandwidth;
+        /*! The elements in band storage. */
+        std::vector<T> _data;
+        /*! The state of the stored elements. */
+        Factorization _factorization = Factorization::NONE;
+
+        /*!
+   * Checks that the matrix has not been factorized yet.
+   *
+   * @throws BSplineException If the matrix has been factorized.
+   */
+        void checkNotFactorized() const {
+            checkNotFailed();
+            if (_factorization != Factorization::NONE) {
+                throw BSplineException(ErrorCode::UNDETERMINED,
+                                       "The matrix has already been factorized.");
+            }
+        }
+
+        /*!
+   * Checks that no factorization of the matrix has failed.
+   *
+   * @throws BSplineException If a factorization has failed.
+   */
+        void checkNotFailed() const {
+            if (_factorization == Factorization::FAILED) {
+                throw BSplineException(ErrorCode::UNDETERMINED,
+                                       "A factorization of the matrix has failed.");
+            }
+        }
+
+        /*!
+   * Marks the matrix as unusable after a factorization failed and throws.
+   *
+   * @param message The message of the exception.
+   * @throws BSplineException Always.
+   */
+        [[noreturn]] void fail(const char *message) {
+            _factorization = Factorization::FAILED;
+            throw BSplineException(ErrorCode::UNDETERMINED, message);
+        }
+
+        /*!
+   * Returns the bandwidth of the lower triangle of a sparse matrix.
+   *
+   * @param matrix The sparse matrix.
+   * @returns The largest i - j of an element (i, j) stored in the matrix.
+   */
+        static size_t lowerBandwidth(const SparseMatrix<T> &matrix) {
+            size_t bandwidth = 0;
+            for (size_t i = 0; i < matrix.rows; i++) {
+                for (size_t k = matrix.rowOffsets[i]; k < matrix.rowOffsets[i + 1]; k++) {
+                    const size_t j = matrix.columnIndices[k];
+                    if (j < i) bandwidth = std::max(bandwidth, i - j);
+                }
+            }
+            return bandwidth;
+        }
+
+    public:
+        /*!
+   * Constructs a matrix with all elements set to zero.
+   *
+   * @param size The number of rows and columns.
+   * @param bandwidth The number of subdiagonals, which may contain nonzero
+   * elements.
+   */
+        BandedSymmetricMatrix(size_t size, size_t bandwidth)
+                : _size(size), _bandwidth(bandwidth),
+                  _data(size * (bandwidth + 1), static_cast<T>(0)) {}
+
+        /*!
+   * Copies the lower triangle of a square sparse matrix, e.g. the matrix
+   * returned by integration::BilinearForm::assemble() for a symmetric form.
+   * The bandwidth is the smallest one covering all stored elements.
+   *
+   * @param matrix The sparse matrix. Its upper triangle is ignored.
+   * @throws BSplineException If the matrix is not square.
+   */
+        explicit BandedSymmetricMatrix(const SparseMatrix<T> &matrix)
+                : BandedSymmetricMatrix(matrix.rows, lowerBandwidth(matrix)) {
+            if (matrix.rows != matrix.cols) {
+                throw BSplineException(ErrorCode::INCONSISTENT_DATA,
+                                       "The matrix must be square.");
+            }
+            for (size_t i = 0; i < matrix.rows; i++) {
+                for (size_t k = matrix.rowOffsets[i]; k < matrix.rowOffsets[i + 1]; k++) {
+                    const size_t j = matrix.columnIndices[k];
+                    if (j <= i) (*this)(i, j) = matrix.values[k];
+                }
+            }
+        }
+
+        /*!
+   * Returns the number of rows and columns.
+   */
+        size_t size() const noexcept { return _size; };
+
+        /*!
+   * Returns the number of stored subdiagonals.
+   */
+        size_t bandwidth() const noexcept { return _bandwidth; };
+
+        /*!
+   * Returns the state of the stored elements.
+   */
+        Factorization getFactorization() const noexcept { return _factorization; };
+
+        /*!
+   * Returns the stored elements (or factors) in the band storage of LAPACK
+   * for the lower triangle, see the class documentation. Their values are
+   * unspecified if a factorization has failed.
+   */
+        const std::vector<T> &getBandStorage() const noexcept { return _data; };
+
+        /*!
+   * Returns a reference to the element (i, j), which is shared with (j, i).
+   * Performs no bounds checks.
+   *
+   * @param i The row index.
+   * @param j The column index. The distance of i and j may not exceed the
+   * bandwidth.
+   * @returns The reference to the element.
+   */
+        T &operator()(size_t i, size_t j) {
+            if (i < j) std::swap(i, j);
+            return _data[(i - j) + j * (_bandwidth + 1)];
+        };
+
+        /*!
+   * Returns the element (i, j). Performs no bounds checks.
+   *
+   * @param i The row index.
+   * @param j The column index. The distance of i and j may not exceed the
+   * bandwidth.
+   * @returns The element.
+   */
+        const T &operator()(size_t i, size_t j) const {
+            if (i < j) std::swap(i, j);
+            return _data[(i - j) + j * (_bandwidth + 1)];
+        };
+
+        /*!
+   * Returns the element (i, j).
+   *
+   * @param i The row index.
+   * @param j The column index.
+   * @throws BSplineException If the access is out of bounds or a factorization
+   * of the matrix has failed.
+   * @returns The element, zero outside of the band.
+   */
+        T at(size_t i, size_t j) const {
+            checkNotFailed();
+            if (i >= _size || j >= _size) {
+                throw BSplineException(ErrorCode::INVALID_ACCESS);
+            }
+            const size_t distance = (i < j) ? j - i : i - j;
+            return (distance > _bandwidth) ? static_cast<T>(0) : (*this)(i, j);
+        }
+
+        /*!
+   * Multiplies the matrix with a vector.
+   *
+   * @param x The vector.
+   * @throws BSplineException If the size of x differs from the size of the
+   * matrix or the matrix has been factorized, also if unsuccessfully.
+   * @returns The product A x.
+   */
+        std::vector<T> multiply(const std::vector<T> &x) const {
+            checkNotFactorized();
+            if (x.size() != _size) {
+                throw BSplineException(ErrorCode::INCONSISTENT_DATA);
+            }
+            std::vector<T> ret(_size, static_cast<T>(0));
+            for (size_t j = 0; j < _size; j++) {
+                ret[j] += (*this)(j, j) * x[j];
+                for (size_t i = j + 1; i < std::min(_size, j + _bandwidth + 1); i++) {
+                    ret[i] += (*this)(i, j) * x[j];
+                    ret[j] += (*this)(i, j) * x[i];
+                }
+            }
+            return ret;
+        }
+
+        /*!
+   * Computes the Cholesky factorization A = L L^T in place, the elements of
+   * the matrix being replaced by L.
+   *
+   * @throws BSplineException If the matrix has already been factorized.
+   * @throws BSplineException If the matrix is not positive definite. Part of
+   * the elements have been overwritten by then, hence the matrix is marked as
+   * Factorization::FAILED and cannot be used anymore.
+   */
+        void factorizeCholesky() {
+            using std::sqrt;
+            checkNotFactorized();
+            for (size_t j = 0; j < _size; j++) {
+                const size_t kBegin = (j > _bandwidth) ? j - _bandwidth : 0;
+                T diagonal = (*this)(j, j);
+                for (size_t k = kBegin; k < j; k++) {
+                    diagonal -= (*this)(j, k) * (*this)(j, k);
+                }
+                if (!(diagonal > static_cast<T>(0))) {
+                    fail("The matrix is not positive definite.");
+                }
+                const T ljj = sqrt(diagonal);
+                (*this)(j, j) = ljj;
+
+                for (size_t i = j + 1; i < std::min(_size, j + _bandwidth + 1); i++) {
+                    T lij = (*this)(i, j);
+                    for (size_t k = (i > _bandwidth) ? i - _bandwidth : 0; k < j; k++) {
+                        lij -= (*this)(i, k) * (*this)(j, k);
+                    }
+                    (*this)(i, j) = lij / ljj;
+                }
+            }
+            _factorization = Factorization::CHOLESKY;
+        }
+
+        /*!
+   * Computes the factorization A = L D L^T without pivoting in place, L being
+   * unit lower triangular and D diagonal. L replaces the subdiagonals, D the
+   * diagonal.
+   *
+   * @throws BSplineException If the matrix has already been factorized.
+   * @throws BSplineException If a pivot vanishes. Part of the elements have been
+   * overwritten by then, hence the matrix is marked as Factorization::FAILED
+   * and cannot be used anymore.
+   */
+        void factorizeLDLT() {
+            checkNotFactorized();
+            for (size_t j = 0; j < _size; j++) {
+                const size_t kBegin = (j > _bandwidth) ? j - _bandwidth : 0;
+                T d = (*this)(j, j);
+                for (size_t k = kBegin; k < j; k++) {
+                    d -= (*this)(j, k) * (*this)(j, k) * (*this)(k, k);
+                }
+                if (d == static_cast<T>(0)) {
+                    fail("The matrix is singular.");
+                }
+                (*this)(j, j) = d;
+
+                for (size_t i = j + 1; i < std::min(_size, j + _bandwidth + 1); i++) {
+                    T lij = (*this)(i, j);
+                    for (size_t k = (i > _bandwidth) ? i - _bandwidth : 0; k < j; k++) {
+                        lij -= (*this)(i, k) * (*this)(j, k) * (*this)(k, k);
+                    }
+                    (*this)(i, j) = lij / d;
+                }
+            }
+            _factorization = Factorization::LDLT;
+        }
+
+        /*!
+   * Solves the linear system A x = b using the factorization of the matrix.
+   *
+   * @param b The right hand side.
+   * @throws BSplineException If the matrix has not been factorized, its
+   * factorization has failed or the size of b differs from the size of the
+   * matrix.
+   * @returns The solution x.
+   */
+        std::vector<T> solve(std::vector<T> b) const {
+            checkNotFailed();
+            if (_factorization == Factorization::NONE) {
+                throw BSplineException(ErrorCode::UNDETERMINED,
+                                       "The matrix has not been factorized.");
+            } else if (b.size() != _size) {
+                throw BSplineException(ErrorCode::INCONSISTENT_DATA);
+            }
+            const bool cholesky = _factorization == Factorization::CHOLESKY;
+
+            // Forward substitution L y = b.
+            for (size_t j = 0; j < _size; j++) {
+                if (cholesky) b[j] /= (*this)(j, j);
+                for (size_t i = j + 1; i < std::min(_size, j + _bandwidth + 1); i++) {
+                    b[i] -= (*this)(i, j) * b[j];
+                }
+            }
+
+            if (!cholesky) {
+                for (size_t j = 0; j < _size; j++) {
+                    b[j] /= (*this)(j, j);
+                }
+            }
+
+            // Back substitution L^T x = y.
+            for (size_t j = _size; j > 0; j--) {
+                T xj = b[j - 1];
+                for (size_t i = j; i < std::min(_size, j + _bandwidth); i++) {
+                    xj -= (*this)(i, j - 1) * b[i];
+                }
+                b[j - 1] = cholesky ? xj / (*this)(j - 1, j - 1) : xj;
+            }
+            return b;
+        }
+    };
+
+}// namespace bspline
+#endif// BSPLINE_BANDEDSYMMETRICMATRIX_H
@@ -0,0 +1,270 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_BASISCACHE_H
+#define BSPLINE_BASISCACHE_H
+
+#include <bspline/BSplineBasis.h>
+#include <bspline/BSplineGenerator.h>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bspline {
+
+    /*!
+ * Hashes the knots of the keys of a BasisCache. Uses std::hash<T> if it is
+ * available for the data type T. For other data types, e.g. multiprecision
+ * types without a std::hash specialization, all knots hash to zero, such that
+ * bases only differing in their knots share a bucket and are told apart by
+ * comparing the knots vectors. May be specialized for such data types.
+ *
+ * @tparam T The data type of the knots.
+ */
+    template<typename T, typename Enable = void>
+    struct KnotHash {
+        size_t operator()(const T & /*knot*/) const noexcept { return 0; }
+    };
+
+#ifndef BSPLINE_DOXYGEN_IGNORE
+    template<typename T>
+    struct KnotHash<T, std::void_t<decltype(std::hash<T>{}(std::declval<const T &>()))>> {
+        size_t operator()(const T &knot) const { return std::hash<T>{}(knot); }
+    };
+#endif// BSPLINE_DOXYGEN_IGNORE
+
+    /*!
+ * Memoizes the bases of BSplines generated from knots vectors, such that
+ * repeated requests for the same knots vector, order and data type share one
+ * immutable BSplineBasis instead of generating it again. The cache is bounded
+ * by an estimate of the memory occupied by the cached bases, the least
+ * recently used bases being evicted first. Evicted bases stay valid as long as
+ * they are referenced. All methods may be called concurrently.
+ */
+    class BasisCache final {
+    private:
+        /*!
+   * A cached basis together with its key.
+   */
+        struct Entry {
+            /*! The type of the basis, which determines the data type and order. */
+            std::type_index type;
+            /*! The hash of the key. */
+            size_t hash;
+            /*! The knots vector, a std::vector<T>. */
+            std::shared_ptr<const void> knots;
+            /*! The basis, a BSplineBasis<T, order>. */
+            std::shared_ptr<const void> basis;
+            /*! The estimated memory occupied by the basis and the knots. */
+            size_t bytes;
+        };
+
+        /*! Guards all members below. */
+        mutable std::mutex _mutex;
+        /*! The maximal memory occupied by the cached bases. */
+        size_t _maxBytes;
+        /*! The memory currently occupied by the cached bases. */
+        size_t _bytes = 0;
+        /*! The cached bases, the most recently used one first. */
+        std::list<Entry> _entries;
+        /*! The entries by the hash of their keys. */
+        std::unordered_multimap<size_t, std::list<Entry>::iterator> _index;
+        /*! The number of requests served from the cache. */
+        size_t _hits = 0;
+        /*! The number of requests which required the generation of a basis. */
+        size_t _misses = 0;
+
+        /*!
+   * Computes the hash of a key, hashing the knots by KnotHash<T>.
+   *
+   * @param type The type of the basis.
+   * @param knots The knots vector.
+   * @returns The hash.
+   */
+        template<typename T>
+        static size_t hashKey(const std::type_index &type, const std::vector<T> &knots) {
+            size_t seed = type.hash_code() ^ knots.size();
+            for (const T &knot: knots) {
+                seed ^= KnotHash<T>{}(knot) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+
+        /*!
+   * Estimates the memory occupied by a basis and its knots vector.
+   *
+   * @param basis The basis.
+   * @param knots The knots vector.
+   * @returns The number of bytes.
+   */
+        template<typename T, size_t order>
+        static size_t estimateBytes(const BSplineBasis<T, order> &basis,
+                                    const std::vector<T> &knots) {
+            return basis.getCoefficients().size() * sizeof(std::array<T, order + 1>) +
+                   3 * (basis.size() + 1) * sizeof(size_t) +
+                   (basis.getGrid().size() + knots.size()) * sizeof(T) +
+                   sizeof(BSplineBasis<T, order>) + sizeof(Entry);
+        }
+
+        /*!
+   * Finds the entry of a key. Requires the mutex to be locked.
+   *
+   * @param type The type of the basis.
+   * @param hash The hash of the key.
+   * @param knots The knots vector.
+   * @returns The iterator referencing the entry or _entries.end().
+   */
+        template<typename T>
+        std::list<Entry>::iterator find(const std::type_index &type, size_t hash,
+                                        const std::vector<T> &knots) {
+            const auto range = _index.equal_range(hash);
+            for (auto it = range.first; it != range.second; it++) {
+                const Entry &entry = *it->second;
+                if (entry.type == type &&
+                    *std::static_pointer_cast<const std::vector<T>>(entry.knots) == knots) {
+                    return it->second;
+                }
+            }
+            return _entries.end();
+        }
+
+        /*!
+   * Removes the least recently used entry. Requires the mutex to be locked.
+   */
+        void evictLeastRecentlyUsed() {
+            const auto entry = std::prev(_entries.end());
+            const auto range = _index.equal_range(entry->hash);
+            for (auto it = range.first; it != range.second; it++) {
+                if (it->second == entry) {
+                    _index.erase(it);
+                    break;
+                }
+            }
+            _bytes -= entry->bytes;
+            _entries.erase(entry);
+        }
+
+    public:
+        /*!
+   * Constructs an empty cache.
+   *
+   * @param maxBytes The maximal memory occupied by the cached bases. Bases
+   * larger than maxBytes are generated, but not cached.
+   */
+        explicit BasisCache(size_t maxBytes) : _maxBytes(maxBytes) {}
+
+        /*!
+   * Returns the basis of all BSplines of order order on the knots vector,
+   * generating it if it is not cached. The basis is generated without holding
+   * the lock, such that concurrent requests for different bases do not block
+   * each other.
+   *
+   * @param knots The knots vector.
+   * @tparam order The order of the BSplines.
+   * @tparam T The data type of the knots vector and the BSplines.
+   * @throws BSplineException If the basis cannot be generated, see
+   * generateBasis().
+   * @returns The shared basis.
+   */
+        template<size_t order, typename T>
+        std::shared_ptr<const BSplineBasis<T, order>> getBasis(const std::vector<T> &knots) {
+            using Basis = BSplineBasis<T, order>;
+            const std::type_index type(typeid(Basis));
+            const size_t hash = hashKey(type, knots);
+
+            {
+                const std::lock_guard<std::mutex> lock(_mutex);
+                const auto it = find(type, hash, knots);
+                if (it != _entries.end()) {
+                    _hits++;
+                    _entries.splice(_entries.begin(), _entries, it);
+                    return std::static_pointer_cast<const Basis>(it->basis);
+                }
+                _misses++;
+            }
+
+            // Moves the generated basis, its coefficients are not copied.
+            const auto basis = std::make_shared<const Basis>(generateBasis<order>(knots));
+            const size_t bytes = estimateBytes(*basis, knots);
+
+            const std::lock_guard<std::mutex> lock(_mutex);
+            // Another thread may have cached the same basis in the meantime.
+            const auto it = find(type, hash, knots);
+            if (it != _entries.end()) {
+                _entries.splice(_entries.begin(), _entries, it);
+                return std::static_pointer_cast<const Basis>(it->basis);
+            } else if (bytes <= _maxBytes) {
+                _entries.push_front(Entry{type, hash, std::make_shared<const std::vector<T>>(knots),
+                                          basis, bytes});
+                _index.emplace(hash, _entries.begin());
+                _bytes += bytes;
+                while (_bytes > _maxBytes) {
+                    evictLeastRecentlyUsed();
+                }
+            }
+            return basis;
+        }
+
+        /*!
+   * Removes all bases from the cache. The counters are retained.
+   */
+        void clear() {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            _index.clear();
+            _entries.clear();
+            _bytes = 0;
+        }
+
+        /*!
+   * Returns the number of cached bases.
+   */
+        size_t size() const {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            return _entries.size();
+        }
+
+        /*!
+   * Returns the estimated memory occupied by the cached bases.
+   */
+        size_t memoryUsage() const {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            return _bytes;
+        }
+
+        /*!
+   * Returns the maximal memory occupied by the cached bases.
+   */
+        size_t maxMemoryUsage() const noexcept { return _maxBytes; }
+
+        /*!
+   * Returns the number of requests served from the cache.
+   */
+        size_t hits() const {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            return _hits;
+        }
+
+        /*!
+   * Returns the number of requests which required the generation of a basis.
+   */
+        size_t misses() const {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            return _misses;
+        }
+    };
+
+}// namespace bspline
+#endif// BSPLINE_BASISCACHE_H
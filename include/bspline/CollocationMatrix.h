@@ -0,0 +1,321 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_COLLOCATIONMATRIX_H
+#define BSPLINE_COLLOCATIONMATRIX_H
+
+#include <bspline/BandedSymmetricMatrix.h>
+#include <bspline/ParallelEvaluator.h>
+#include <bspline/Spline.h>
+#include <bspline/SparseMatrix.h>
+#include <bspline/SplineView.h>
+#include <bspline/exceptions/BSplineException.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace bspline {
+    using namespace bspline::exceptions;
+
+    /*!
+ * Sparse matrix in compressed sparse row (CSR) format holding the values
+ * \f$B_{ij} = b_j(x_i)\f$ of a set of splines \f$b_j\f$ at a set of points
+ * \f$x_i\f$. Only nonzero values are stored.
+ *
+ * @tparam T The datatype of the values.
+ */
+    template<typename T>
+    using CollocationMatrix = SparseMatrix<T>;
+
+#ifndef BSPLINE_DOXYGEN_IGNORE
+    namespace internal {
+
+        /*!
+   * Assembles the collocation matrix of splines defined on a common grid. For
+   * each interval of the grid, the splines which may be nonzero on it are
+   * listed once, such that each point requires a single interval lookup and
+   * the evaluation of only these splines.
+   *
+   * @tparam T The datatype of the splines.
+   * @tparam order The order of the splines.
+   */
+        template<typename T, size_t order>
+        class CollocationAssembler final {
+        private:
+            /*! Views of the splines. */
+            std::vector<SplineView<T, order>> _splines;
+            /*!
+     * The candidates of interval g of the grid are stored at the indices
+     * [_intervalOffsets[g], _intervalOffsets[g + 1]) of _intervalSplines.
+     */
+            std::vector<size_t> _intervalOffsets;
+            /*! The indices of the candidate splines of all intervals. */
+            std::vector<size_t> _intervalSplines;
+            /*! The maximal number of candidates of an interval. */
+            size_t _maxCandidates = 0;
+
+            /*!
+     * Calls f(g, j) for every grid interval g, on which spline j may be
+     * nonzero. Besides the intervals of its support, this is the interval
+     * preceding the support, whose right boundary is part of the support.
+     *
+     * @param f The callable.
+     */
+            template<typename F>
+            void forEachCandidate(const F &f) const {
+                for (size_t j = 0; j < _splines.size(); j++) {
+                    const SplineView<T, order> &spline = _splines[j];
+                    if (!spline.containsIntervals()) continue;
+                    const size_t first = spline.getStartIndex();
+                    const size_t last = spline.getEndIndex() - 1;
+                    for (size_t g = (first > 0 ? first - 1 : 0); g < last; g++) {
+                        f(g, j);
+                    }
+                }
+            }
+
+        public:
+            /*!
+     * Constructs an assembler for a range of splines.
+     *
+     * @param splinesBegin The iterator referencing the first spline.
+     * @param splinesEnd The iterator referencing the end of the splines.
+     * @tparam SplineIter An iterator referencing a spline of type
+     * Spline<T, order> or SplineView<T, order>.
+     * @throws BSplineException If the range of splines is empty or the splines
+     * are defined on different grids.
+     */
+            template<typename SplineIter>
+            CollocationAssembler(SplineIter splinesBegin, SplineIter splinesEnd) {
+                if (splinesBegin == splinesEnd) {
+                    throw BSplineException(ErrorCode::MISSING_DATA,
+                                           "The number of splines may not be zero.");
+                }
+                const Grid<T> grid = splinesBegin->getSupport().getGrid();
+                for (auto it = splinesBegin; it != splinesEnd; it++) {
+                    if (it->getSupport().getGrid() != grid) {
+                        throw BSplineException(ErrorCode::DIFFERING_GRIDS);
+                    }
+                    _splines.push_back(SplineView<T, order>(*it));
+                }
+
+                // Counting sort of the candidates by interval.
+                _intervalOffsets.assign(grid.size(), 0);
+                forEachCandidate([this](size_t g, size_t) { _intervalOffsets[g + 1]++; });
+                for (size_t g = 1; g < _intervalOffsets.size(); g++) {
+                    _maxCandidates = std::max(_maxCandidates, _intervalOffsets[g]);
+                    _intervalOffsets[g] += _intervalOffsets[g - 1];
+                }
+                _intervalSplines.resize(_intervalOffsets.back());
+                std::vector<size_t> next(_intervalOffsets.begin(), _intervalOffsets.end() - 1);
+                forEachCandidate([&](size_t g, size_t j) { _intervalSplines[next[g]++] = j; });
+            }
+
+            /*!
+     * Builds the collocation matrix.
+     *
+     * @param xBegin Random access iterator referencing the first point.
+     * @param xEnd Random access iterator referencing the end of the points.
+     * @param nChunks The number of chunks the points are split into.
+     * @param parallelFor Callable executing task(c) for all c in [0, nTasks)
+     * when called as parallelFor(nTasks, task).
+     * @returns The collocation matrix.
+     */
+            template<typename InputIt, typename ParallelFor>
+            CollocationMatrix<T> assemble(InputIt xBegin, InputIt xEnd, size_t nChunks,
+                                          const ParallelFor &parallelFor) const {
+                const Grid<T> &grid = _splines.front().getGrid();
+                const size_t nPoints = std::distance(xBegin, xEnd);
+                nChunks = std::max<size_t>(std::min(nChunks, nPoints), 1);
+
+                CollocationMatrix<T> ret;
+                ret.rows = nPoints;
+                ret.cols = _splines.size();
+                ret.rowOffsets.assign(nPoints + 1, 0);
+
+                // The rows are first written with a fixed width, then compacted.
+                std::vector<size_t> columns(nPoints * _maxCandidates);
+                std::vector<T> values(nPoints * _maxCandidates);
+
+                const auto chunkBegin = [&](size_t c) { return nPoints * c / nChunks; };
+
+                parallelFor(nChunks, [&](size_t c) {
+                    for (size_t i = chunkBegin(c); i < chunkBegin(c + 1); i++) {
+                        const T &x = xBegin[i];
+                        const auto g = grid.findInterval(x);
+                        if (!g) continue;
+
+                        size_t count = 0;
+                        for (size_t k = _intervalOffsets[*g]; k < _intervalOffsets[*g + 1]; k++) {
+                            const size_t j = _intervalSplines[k];
+                            const T value = _splines[j].evaluateInGridInterval(x, *g);
+                            if (value != static_cast<T>(0)) {
+                                columns[i * _maxCandidates + count] = j;
+                                values[i * _maxCandidates + count] = value;
+                                count++;
+                            }
+                        }
+                        ret.rowOffsets[i + 1] = count;
+                    }
+                });
+
+                for (size_t i = 0; i < nPoints; i++) {
+                    ret.rowOffsets[i + 1] += ret.rowOffsets[i];
+                }
+                ret.columnIndices.resize(ret.rowOffsets.back());
+                ret.values.resize(ret.rowOffsets.back());
+
+                parallelFor(nChunks, [&](size_t c) {
+                    for (size_t i = chunkBegin(c); i < chunkBegin(c + 1); i++) {
+                        const size_t count = ret.rowOffsets[i + 1] - ret.rowOffsets[i];
+                        std::copy_n(columns.begin() + i * _maxCandidates, count,
+                                    ret.columnIndices.begin() + ret.rowOffsets[i]);
+                        std::copy_n(values.begin() + i * _maxCandidates, count,
+                                    ret.values.begin() + ret.rowOffsets[i]);
+                    }
+                });
+                return ret;
+            }
+        };
+    }// namespace internal
+#endif// BSPLINE_DOXYGEN_IGNORE
+
+    /*!
+ * Builds the collocation matrix \f$B_{ij} = b_j(x_i)\f$ of the splines
+ * \f$b_j\f$ at the points \f$x_i\f$, e.g. for least-squares fitting. The splines
+ * must be defined on the same grid. Each point requires a single interval
+ * lookup, after which only the splines which may be nonzero on the interval
+ * are evaluated. For the B-splines returned by
+ * BSplineGenerator::generateBSplines(), these are order + 1 splines. At a grid
+ * point, the splines whose support begins there are evaluated as well, since
+ * a support contains its first point; their values vanish up to rounding.
+ * See collocationMatrix(const SplineCollection &, const XCollection &,
+ * ParallelEvaluator &) for a multithreaded variant.
+ *
+ * @param splines The splines \f$b_j\f$. Must provide begin() and end()
+ * iterators.
+ * @param xs The points \f$x_i\f$. Must provide begin() and end() random access
+ * iterators.
+ * @tparam SplineCollection A collection of splines.
+ * @tparam XCollection The type of the collection of points.
+ * @throws BSplineException If the collection of splines is empty or the splines
+ * are defined on different grids.
+ * @returns The collocation matrix, with one row per point and one column per
+ * spline.
+ */
+    template<typename SplineCollection, typename XCollection>
+    CollocationMatrix<typename SplineCollection::value_type::data_type>
+    collocationMatrix(const SplineCollection &splines, const XCollection &xs) {
+        using Spline = typename SplineCollection::value_type;
+        const internal::CollocationAssembler<typename Spline::data_type,
+                                             Spline::spline_order>
+                assembler(splines.begin(), splines.end());
+        return assembler.assemble(xs.begin(), xs.end(), 1,
+                                  [](size_t nTasks, const std::function<void(size_t)> &task) {
+                                      for (size_t c = 0; c < nTasks; c++) task(c);
+                                  });
+    }
+
+    /*!
+ * Builds the collocation matrix \f$B_{ij} = b_j(x_i)\f$ of the splines
+ * \f$b_j\f$ at the points \f$x_i\f$, the rows being assembled in parallel on
+ * the threads of an evaluator. See collocationMatrix(const SplineCollection &,
+ * const XCollection &).
+ *
+ * @param splines The splines \f$b_j\f$. Must provide begin() and end()
+ * iterators.
+ * @param xs The points \f$x_i\f$. Must provide begin() and end() random access
+ * iterators.
+ * @param evaluator The evaluator providing the threads.
+ * @tparam SplineCollection A collection of splines.
+ * @tparam XCollection The type of the collection of points.
+ * @throws BSplineException If the collection of splines is empty or the splines
+ * are defined on different grids.
+ * @returns The collocation matrix, with one row per point and one column per
+ * spline.
+ */
+    template<typename SplineCollection, typename XCollection>
+    CollocationMatrix<typename SplineCollection::value_type::data_type>
+    collocationMatrix(const SplineCollection &splines, const XCollection &xs,
+                      ParallelEvaluator &evaluator) {
+        using Spline = typename SplineCollection::value_type;
+        const internal::CollocationAssembler<typename Spline::data_type,
+                                             Spline::spline_order>
+                assembler(splines.begin(), splines.end());
+        const size_t nPoints = std::distance(xs.begin(), xs.end());
+        return assembler.assemble(
+                xs.begin(), xs.end(), evaluator.numberOfChunks(nPoints),
+                [&evaluator](size_t nTasks, const std::function<void(size_t)> &task) {
+                    evaluator.parallelFor(nTasks, task);
+                });
+    }
+
+    /*!
+ * Fits a linear combination of the splines \f$b_j\f$ to the data
+ * \f$(x_i, y_i)\f$ in the least-squares sense, i.e. minimizes
+ * \f$\sum_i (\sum_j c_j b_j(x_i) - y_i)^2\f$. The normal equations
+ * \f$B^T B c = B^T y\f$ of the collocation matrix \f$B\f$ are set up as a
+ * BandedSymmetricMatrix and solved by a banded Cholesky factorization, without
+ * any external linear algebra library. If the number of points equals the
+ * number of splines, the result interpolates the data. As the normal equations
+ * square the condition number of \f$B\f$, the interpolation routines in
+ * bspline::interpolation should be preferred for ill-conditioned problems.
+ *
+ * @param splines The splines \f$b_j\f$. Must provide begin() and end()
+ * iterators.
+ * @param xs The points \f$x_i\f$. Must provide begin() and end() random access
+ * iterators.
+ * @param ys The values \f$y_i\f$. Must provide begin() and end() iterators.
+ * @tparam SplineCollection A collection of splines.
+ * @tparam XCollection The type of the collection of points.
+ * @tparam YCollection The type of the collection of values.
+ * @throws BSplineException If the collection of splines is empty, the splines
+ * are defined on different grids, the numbers of points and values differ or
+ * the normal equations are singular.
+ * @returns The fitted spline.
+ */
+    template<typename SplineCollection, typename XCollection, typename YCollection>
+    auto leastSquaresFit(const SplineCollection &splines, const XCollection &xs,
+                         const YCollection &ys) {
+        using T = typename SplineCollection::value_type::data_type;
+        const CollocationMatrix<T> b = collocationMatrix(splines, xs);
+        if (static_cast<size_t>(std::distance(ys.begin(), ys.end())) != b.rows) {
+            throw BSplineException(ErrorCode::INCONSISTENT_DATA,
+                                   "The numbers of points and values must coincide.");
+        }
+
+        // Two splines are coupled if they are both nonzero at some point.
+        size_t bandwidth = 0;
+        for (size_t i = 0; i < b.rows; i++) {
+            if (b.rowOffsets[i + 1] > b.rowOffsets[i]) {
+                bandwidth = std::max(bandwidth, b.columnIndices[b.rowOffsets[i + 1] - 1] -
+                                                        b.columnIndices[b.rowOffsets[i]]);
+            }
+        }
+
+        BandedSymmetricMatrix<T> normal(b.cols, bandwidth);
+        std::vector<T> rhs(b.cols, static_cast<T>(0));
+        auto y = ys.begin();
+        for (size_t i = 0; i < b.rows; i++, y++) {
+            for (size_t k = b.rowOffsets[i]; k < b.rowOffsets[i + 1]; k++) {
+                const size_t j = b.columnIndices[k];
+                rhs[j] += b.values[k] * (*y);
+                for (size_t l = b.rowOffsets[i]; l <= k; l++) {
+                    normal(j, b.columnIndices[l]) += b.values[k] * b.values[l];
+                }
+            }
+        }
+
+        normal.factorizeCholesky();
+        return linearCombination(normal.solve(std::move(rhs)), splines);
+    }
+
+}// namespace bspline
+#endif// BSPLINE_COLLOCATIONMATRIX_H
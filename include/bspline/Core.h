@@ -5,8 +5,18 @@
  * ########################################################################
  */
 
+#include <bspline/BSplineBasis.h>
 #include <bspline/BSplineGenerator.h>
+#include <bspline/BandedSymmetricMatrix.h>
+#include <bspline/BasisCache.h>
+#include <bspline/CollocationMatrix.h>
+#include <bspline/ParallelEvaluator.h>
+#include <bspline/SoASpline.h>
+#include <bspline/SparseMatrix.h>
 #include <bspline/Spline.h>
+#include <bspline/SplineCursor.h>
+#include <bspline/SplineView.h>
+#include <bspline/UniformBSplineBasis.h>
 #include <bspline/integration/BilinearForm.h>
 #include <bspline/integration/LinearForm.h>
 #include <bspline/operators/CompoundOperators.h>
@@ -0,0 +1,239 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_PARALLELEVALUATOR_H
+#define BSPLINE_PARALLELEVALUATOR_H
+
+#include <bspline/Spline.h>
+#include <bspline/internal/ThreadPool.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace bspline {
+
+    /*!
+ * Evaluates splines at large sets of points using a pool of threads. The points
+ * are split into contiguous chunks, each of which is evaluated by
+ * Spline::evaluate(InputIt, InputIt, OutputIt), such that sorted points are
+ * still processed by a walk along the support.
+ *
+ * Splines are not modified by evaluation, hence the same splines may be
+ * evaluated by several threads at once.
+ *
+ * The threads of an evaluator can also be passed to the multithreaded variants
+ * of BSplineGenerator::generateBSplines(), bspline::collocationMatrix() and
+ * integration::BilinearForm::assemble().
+ */
+    class ParallelEvaluator final {
+    public:
+        /*!
+   * Minimal number of points per chunk. Smaller sets of points are not split.
+   */
+        static constexpr size_t MIN_CHUNK_SIZE = 4096;
+
+        /*!
+   * Number of chunks per thread, if enough points are provided. Several chunks
+   * per thread balance the load if the evaluation costs of the chunks differ.
+   */
+        static constexpr size_t CHUNKS_PER_THREAD = 4;
+
+    private:
+        /*! The threads evaluating the chunks. */
+        internal::ThreadPool _pool;
+
+        /*!
+   * Evaluates the spline at the points in the range [xBegin, xEnd). If the
+   * points are sorted, only those within the support are passed to the spline,
+   * the others are located by binary search and set to zero.
+   *
+   * @param spline The spline to evaluate.
+   * @param xBegin Random access iterator referencing the first point.
+   * @param xEnd Random access iterator referencing the end of the points.
+   * @param out Random access iterator the values are written to.
+   * @param sorted True if the points are sorted in ascending order.
+   * @tparam S The type of the spline, Spline or SplineView.
+   */
+        template<typename S, typename InputIt, typename OutputIt>
+        static void evaluateChunk(const S &spline, InputIt xBegin, InputIt xEnd,
+                                  OutputIt out, bool sorted) {
+            using T = typename S::data_type;
+            const Support<T> &support = spline.getSupport();
+            if (!sorted || !support.containsIntervals()) {
+                spline.evaluate(xBegin, xEnd, out);
+                return;
+            }
+
+            const auto first = std::lower_bound(xBegin, xEnd, support.front());
+            const auto last = std::upper_bound(first, xEnd, support.back());
+            out = std::fill_n(out, std::distance(xBegin, first), static_cast<T>(0));
+            out = spline.evaluate(first, last, out);
+            std::fill_n(out, std::distance(last, xEnd), static_cast<T>(0));
+        }
+
+    public:
+        /*!
+   * Constructs an evaluator.
+   *
+   * @param nThreads The number of threads used for the evaluation, including
+   * the calling thread. Defaults to the number of hardware threads.
+   */
+        explicit ParallelEvaluator(
+                size_t nThreads = std::thread::hardware_concurrency())
+            : _pool(nThreads) {}
+
+        /*!
+   * Returns the number of threads used for the evaluation, including the
+   * calling thread.
+   *
+   * @returns The number of threads.
+   */
+        size_t getThreadCount() const { return _pool.size(); };
+
+        /*!
+   * Returns the number of chunks a job is split into, such that each chunk
+   * covers at least MIN_CHUNK_SIZE units of work and each thread receives
+   * about CHUNKS_PER_THREAD chunks.
+   *
+   * @param nPoints The number of points, or units of work comparable to the
+   * evaluation of a point, per spline.
+   * @param nSplines The number of splines, each of which is split separately.
+   * @returns The number of chunks per spline.
+   */
+        size_t numberOfChunks(size_t nPoints, size_t nSplines = 1) const {
+            const size_t maxChunks = std::max<size_t>(nPoints / MIN_CHUNK_SIZE, 1);
+            const size_t targetChunks =
+                    (CHUNKS_PER_THREAD * _pool.size() + nSplines - 1) / nSplines;
+            return std::min(maxChunks, targetChunks);
+        }
+
+        /*!
+   * Executes task(i) for all i in [0, nTasks) on the threads of the evaluator
+   * and blocks until all tasks are finished. If tasks throw, the remaining
+   * tasks are still executed and the first exception is rethrown afterwards.
+   * Tasks may call parallelFor() again, in which case the nested tasks are
+   * executed by the calling thread.
+   *
+   * @param nTasks The number of tasks.
+   * @param task The task, called with the index of the task.
+   */
+        void parallelFor(size_t nTasks, const std::function<void(size_t)> &task) {
+            _pool.parallelFor(nTasks, task);
+        }
+
+        /*!
+   * Evaluates the spline at all points in the range [xBegin, xEnd) and writes
+   * the results to the range beginning at out. Produces the same values as
+   * Spline::evaluate(InputIt, InputIt, OutputIt).
+   *
+   * @param spline The spline to evaluate.
+   * @param xBegin Random access iterator referencing the first point.
+   * @param xEnd Random access iterator referencing the end of the points.
+   * @param out Random access iterator the values of the spline are written to.
+   * @tparam InputIt Random access iterator type referencing values of type T.
+   * @tparam OutputIt Random access iterator type accepting values of type T.
+   * @returns The output iterator pointing behind the last value written.
+   */
+        template<typename T, size_t order, typename InputIt, typename OutputIt>
+        OutputIt evaluate(const Spline<T, order> &spline, InputIt xBegin,
+                          InputIt xEnd, OutputIt out) {
+            return tabulate(&spline, &spline + 1, xBegin, xEnd, out);
+        }
+
+        /*!
+   * Evaluates the spline at all points of the collection xs. See
+   * evaluate(const Spline<T, order> &, InputIt, InputIt, OutputIt).
+   *
+   * @param spline The spline to evaluate.
+   * @param xs The points at which to evaluate the spline. Must provide begin()
+   * and end() random access iterators.
+   * @tparam XCollection The type of the collection of points.
+   * @returns The values of the spline at the points xs.
+   */
+        template<typename T, size_t order, typename XCollection>
+        std::vector<T> evaluate(const Spline<T, order> &spline,
+                                const XCollection &xs) {
+            std::vector<T> ret(std::distance(xs.begin(), xs.end()));
+            evaluate(spline, xs.begin(), xs.end(), ret.begin());
+            return ret;
+        }
+
+        /*!
+   * Evaluates all splines in the range [splinesBegin, splinesEnd) at all points
+   * in the range [xBegin, xEnd). The values of the k-th spline are written to
+   * the k-th block of n consecutive elements beginning at out, where n is the
+   * number of points.
+   *
+   * @param splinesBegin Random access iterator referencing the first spline.
+   * @param splinesEnd Random access iterator referencing the end of the
+   * splines.
+   * @param xBegin Random access iterator referencing the first point.
+   * @param xEnd Random access iterator referencing the end of the points.
+   * @param out Random access iterator the values of the splines are written
+   * to.
+   * @tparam SplineIter Random access iterator type referencing splines or spline
+   * views, e.g. the iterator of a BSplineBasis.
+   * @tparam InputIt Random access iterator type referencing values of the
+   * datatype of the splines.
+   * @tparam OutputIt Random access iterator type accepting values of the
+   * datatype of the splines.
+   * @returns The output iterator pointing behind the last value written.
+   */
+        template<typename SplineIter, typename InputIt, typename OutputIt>
+        OutputIt tabulate(SplineIter splinesBegin, SplineIter splinesEnd,
+                          InputIt xBegin, InputIt xEnd, OutputIt out) {
+            const size_t nSplines = std::distance(splinesBegin, splinesEnd);
+            const size_t nPoints = std::distance(xBegin, xEnd);
+            if (nSplines == 0 || nPoints == 0) return out;
+
+            const bool sorted = std::is_sorted(xBegin, xEnd);
+            const size_t nChunks = numberOfChunks(nPoints, nSplines);
+
+            _pool.parallelFor(nSplines * nChunks, [&](size_t task) {
+                const size_t splineIndex = task / nChunks;
+                const size_t chunkIndex = task % nChunks;
+                const size_t first = nPoints * chunkIndex / nChunks;
+                const size_t last = nPoints * (chunkIndex + 1) / nChunks;
+
+                evaluateChunk(splinesBegin[splineIndex], xBegin + first,
+                              xBegin + last, out + (splineIndex * nPoints + first),
+                              sorted);
+            });
+            return out + nSplines * nPoints;
+        }
+
+        /*!
+   * Evaluates all splines of the collection splines at all points of the
+   * collection xs. See tabulate(SplineIter, SplineIter, InputIt, InputIt,
+   * OutputIt).
+   *
+   * @param splines The splines to evaluate. Must provide begin() and end()
+   * random access iterators.
+   * @param xs The points at which to evaluate the splines. Must provide begin()
+   * and end() random access iterators.
+   * @tparam SplineCollection The type of the collection of splines.
+   * @tparam XCollection The type of the collection of points.
+   * @returns The values of the splines, where the values of the k-th spline
+   * occupy the k-th block of xs.size() consecutive elements.
+   */
+        template<typename SplineCollection, typename XCollection>
+        std::vector<typename SplineCollection::value_type::data_type> tabulate(
+                const SplineCollection &splines, const XCollection &xs) {
+            std::vector<typename SplineCollection::value_type::data_type> ret(
+                    std::distance(splines.begin(), splines.end()) *
+                    std::distance(xs.begin(), xs.end()));
+            tabulate(splines.begin(), splines.end(), xs.begin(), xs.end(),
+                     ret.begin());
+            return ret;
+        }
+    };
+
+}// namespace bspline
+#endif// BSPLINE_PARALLELEVALUATOR_H
@@ -0,0 +1,319 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_SOASPLINE_H
+#define BSPLINE_SOASPLINE_H
+
+#include <bspline/Spline.h>
+#include <bspline/SplineView.h>
+#include <bspline/internal/simd.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace bspline {
+
+    /*!
+ * Read-only companion of Spline, which stores the coefficients in
+ * structure-of-arrays (power-major) layout: The coefficients belonging to the
+ * same power are stored contiguously for all intervals, in arrays aligned to
+ * internal::SIMD_ALIGNMENT bytes. This layout allows to vectorize the
+ * evaluation at points in different intervals and the integration across
+ * intervals.
+ *
+ * @tparam T Datatype of the spline.
+ * @tparam order Order of the spline.
+ */
+    template<typename T, size_t order>
+    class SoASpline final {
+    private:
+        /*! Number of coefficients per interval. */
+        static constexpr size_t ARRAY_SIZE = order + 1;
+        /*! Number of elements of type T per aligned block. */
+        static constexpr size_t BLOCK_SIZE =
+                std::max<size_t>(internal::SIMD_ALIGNMENT / sizeof(T), 1);
+
+        /*! Vector type with aligned storage. */
+        using AlignedVector = std::vector<T, internal::AlignedAllocator<T>>;
+
+        /*! The support of this spline. */
+        Support<T> _support;
+        /*!
+   * The distance between the coefficients of consecutive powers: The number
+   * of intervals, rounded up to a multiple of BLOCK_SIZE.
+   */
+        size_t _stride;
+        /*!
+   * The coefficients. The coefficient of power p on interval i is located at
+   * index p * _stride + i.
+   */
+        AlignedVector _coefficients;
+        /*! The midpoints of the intervals. */
+        AlignedVector _midpoints;
+        /*! The half widths of the intervals. */
+        AlignedVector _halfWidths;
+
+        /*!
+   * Collects the coefficients of one interval.
+   *
+   * @param intervalIndex The index of the interval.
+   * @returns The coefficients of the interval, as stored by Spline.
+   */
+        std::array<T, ARRAY_SIZE> intervalCoefficients(size_t intervalIndex) const {
+            std::array<T, ARRAY_SIZE> coeffs;
+            for (size_t p = 0; p < ARRAY_SIZE; p++) {
+                coeffs[p] = _coefficients[p * _stride + intervalIndex];
+            }
+            return coeffs;
+        }
+
+    public:
+        /*!
+   * Provides acces to the data type T of the spline.
+   */
+        using data_type = T;
+
+        /*!
+   * Provides access to the order of the spline.
+   */
+        static constexpr size_t spline_order = order;
+
+        /*!
+   * Constructs the structure-of-arrays representation of a spline.
+   *
+   * @param spline The spline.
+   */
+        explicit SoASpline(const Spline<T, order> &spline)
+                : SoASpline(SplineView<T, order>(spline)) {}
+
+        /*!
+   * Constructs the structure-of-arrays representation of a spline view, e.g.
+   * of an element of a BSplineBasis.
+   *
+   * @param spline The view of the spline.
+   */
+        explicit SoASpline(const SplineView<T, order> &spline)
+                : _support(spline.getSupport()),
+                  _stride((_support.numberOfIntervals() + BLOCK_SIZE - 1) / BLOCK_SIZE *
+                          BLOCK_SIZE),
+                  _coefficients(ARRAY_SIZE * _stride, static_cast<T>(0)) {
+            const size_t nIntervals = _support.numberOfIntervals();
+            const auto *coefficients = spline.getCoefficients();
+            _midpoints.reserve(nIntervals);
+            _halfWidths.reserve(nIntervals);
+            for (size_t i = 0; i < nIntervals; i++) {
+                for (size_t p = 0; p < ARRAY_SIZE; p++) {
+                    _coefficients[p * _stride + i] = coefficients[i][p];
+                }
+                _midpoints.push_back(_support.intervalMidpoint(i));
+                _halfWidths.push_back(_support.intervalHalfWidth(i));
+            }
+        }
+
+        /*!
+   * Converts this spline back to the array-of-structures representation.
+   *
+   * @returns The spline.
+   */
+        Spline<T, order> toSpline() const {
+            const size_t nIntervals = _support.numberOfIntervals();
+            typename Spline<T, order>::coefficients_type coefficients;
+            coefficients.reserve(nIntervals);
+            for (size_t i = 0; i < nIntervals; i++) {
+                coefficients.push_back(intervalCoefficients(i));
+            }
+            return Spline<T, order>(_support, std::move(coefficients));
+        }
+
+        /*!
+   * Returns the spline's support.
+   */
+        const Support<T> &getSupport() const noexcept { return _support; };
+
+        /*!
+   * Returns the coefficients of the power p on all intervals of the support.
+   *
+   * @param p The power. Must not exceed the order of the spline.
+   * @returns Pointer to the support.numberOfIntervals() coefficients of the
+   * power p. The pointer is aligned to internal::SIMD_ALIGNMENT bytes.
+   */
+        const T *getCoefficients(size_t p) const {
+            return _coefficients.data() + p * _stride;
+        };
+
+        /*!
+   * Evaluates the spline at point x.
+   *
+   * @param x Point at which to evaluate the spline. If x is outside of the
+   * support of the spline, zero is returned.
+   * @returns The value of the spline at point x.
+   */
+        T operator()(const T &x) const {
+            const auto intervalIndex = _support.findInterval(x);
+            if (!intervalIndex) return static_cast<T>(0);
+
+            T result;
+            internal::evaluateIntervalsGather<ARRAY_SIZE>(
+                    &x, &(*intervalIndex), 1, _coefficients.data(), _stride,
+                    _midpoints.data(), &result);
+            return result;
+        };
+
+        /*!
+   * Evaluates the spline at all points in the range [xBegin, xEnd) and writes
+   * the results to the range beginning at out. Sorted points are processed as
+   * by Spline::evaluate(InputIt, InputIt, OutputIt). For unsorted points, the
+   * intervals of a block of points are looked up first, then the coefficients
+   * of each power are gathered from one contiguous array and the block is
+   * evaluated with vector registers.
+   *
+   * @param xBegin Forward iterator referencing the first point.
+   * @param xEnd Forward iterator referencing the end of the points.
+   * @param out Output iterator the values of the spline are written to.
+   * @tparam InputIt Forward iterator type referencing values of type T.
+   * @tparam OutputIt Output iterator type accepting values of type T.
+   * @returns The output iterator pointing behind the last value written.
+   */
+        template<typename InputIt, typename OutputIt>
+        OutputIt evaluate(InputIt xBegin, InputIt xEnd, OutputIt out) const {
+            if (!_support.containsIntervals()) {
+                for (auto it = xBegin; it != xEnd; it++, out++) {
+                    *out = static_cast<T>(0);
+                }
+                return out;
+            }
+
+            std::array<T, internal::SIMD_BATCH_SIZE> xs;
+            std::array<T, internal::SIMD_BATCH_SIZE> values;
+            const T *points = &_support[0];
+            const T &back = _support.back();
+
+            if (std::is_sorted(xBegin, xEnd)) {
+                // Walk along the support as Spline::evaluate() does. The points of
+                // one interval share the coefficients, which are broadcast.
+                auto it = xBegin;
+                for (; it != xEnd && *it < points[0]; it++, out++) {
+                    *out = static_cast<T>(0);
+                }
+
+                size_t intervalIndex = 0;
+                std::array<T, ARRAY_SIZE> coeffs = intervalCoefficients(0);
+                while (it != xEnd && *it <= back) {
+                    if (*it > points[intervalIndex + 1]) {
+                        intervalIndex = *it > points[intervalIndex + 2]
+                                                ? _support.findInterval(*it).value()
+                                                : intervalIndex + 1;
+                        coeffs = intervalCoefficients(intervalIndex);
+                    }
+
+                    const T &intervalEnd = points[intervalIndex + 1];
+                    size_t n = 0;
+                    for (; it != xEnd && n < xs.size() && *it <= intervalEnd; it++) {
+                        xs[n++] = *it;
+                    }
+                    internal::evaluateIntervalBatch(xs.data(), n, coeffs,
+                                                    _midpoints[intervalIndex], values.data());
+                    out = std::copy(values.begin(), values.begin() + n, out);
+                }
+
+                for (; it != xEnd; it++, out++) {
+                    *out = static_cast<T>(0);
+                }
+                return out;
+            }
+
+            // Unsorted points: Locate a block of points, then gather the coefficients
+            // of their intervals.
+            std::array<size_t, internal::SIMD_BATCH_SIZE> intervals;
+            std::array<bool, internal::SIMD_BATCH_SIZE> inside;
+            for (auto it = xBegin; it != xEnd;) {
+                size_t n = 0;
+                for (; it != xEnd && n < xs.size(); it++, n++) {
+                    xs[n] = *it;
+                    inside[n] = (xs[n] >= points[0] && xs[n] <= back);
+                    // The value of points outside the support is discarded, any
+                    // interval will do.
+                    intervals[n] = inside[n] ? _support.findInterval(xs[n]).value() : 0;
+                }
+
+                internal::evaluateIntervalsGather<ARRAY_SIZE>(
+                        xs.data(), intervals.data(), n, _coefficients.data(), _stride,
+                        _midpoints.data(), values.data());
+
+                for (size_t i = 0; i < n; i++, out++) {
+                    *out = inside[i] ? values[i] : static_cast<T>(0);
+                }
+            }
+            return out;
+        }
+
+        /*!
+   * Evaluates the spline at all points of the collection xs. See
+   * evaluate(InputIt, InputIt, OutputIt).
+   *
+   * @param xs The points at which to evaluate the spline. Must provide begin()
+   * and end() forward iterators.
+   * @tparam XCollection The type of the collection of points.
+   * @returns The values of the spline at the points xs.
+   */
+        template<typename XCollection>
+        std::vector<T> evaluate(const XCollection &xs) const {
+            std::vector<T> ret(std::distance(xs.begin(), xs.end()));
+            evaluate(xs.begin(), xs.end(), ret.begin());
+            return ret;
+        }
+
+        /*!
+   * Calculates the integral \f$\int\limits_{-\infty}^{\infty}\mathrm{d}x~s(x)\f$
+   * of the spline. The polynomials of all intervals are integrated
+   * simultaneously, one power at a time. The result coincides with the one of
+   * integration::LinearForm<IdentityOperator>.
+   *
+   * @returns The integral of the spline.
+   */
+        T integrate() const {
+            constexpr size_t endIndex = ARRAY_SIZE - (ARRAY_SIZE % 2 == 0 ? 2 : 1);
+            const size_t nIntervals = _support.numberOfIntervals();
+            const T *h = _halfWidths.data();
+
+            AlignedVector results(nIntervals);
+            const T *c = getCoefficients(endIndex);
+            for (size_t i = 0; i < nIntervals; i++) {
+                results[i] = c[i] / static_cast<T>(endIndex + 1);
+            }
+
+            for (size_t p = endIndex; p >= 2;) {
+                p -= 2;
+                c = getCoefficients(p);
+                for (size_t i = 0; i < nIntervals; i++) {
+                    results[i] = (h[i] * h[i]) * results[i] + c[i] / static_cast<T>(p + 1);
+                }
+            }
+
+            T result = static_cast<T>(0);
+            for (size_t i = 0; i < nIntervals; i++) {
+                result += static_cast<T>(2) * h[i] * results[i];
+            }
+            return result;
+        }
+    };
+
+    /*!
+ * Deduction guide for the structure-of-arrays representation of a spline.
+ */
+    template<typename T, size_t order>
+    SoASpline(const Spline<T, order> &spline) -> SoASpline<T, order>;
+
+    /*!
+ * Deduction guide for the structure-of-arrays representation of a spline view.
+ */
+    template<typename T, size_t order>
+    SoASpline(const SplineView<T, order> &spline) -> SoASpline<T, order>;
+
+}// namespace bspline
+#endif// BSPLINE_SOASPLINE_H
@@ -0,0 +1,74 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_SPARSEMATRIX_H
+#define BSPLINE_SPARSEMATRIX_H
+
+#include <bspline/exceptions/BSplineException.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace bspline {
+    using namespace bspline::exceptions;
+
+    /*!
+ * Sparse matrix in compressed sparse row (CSR) format, e.g. a collocation
+ * matrix (see collocationMatrix()) or the matrix of a bilinear form over a set
+ * of splines (see integration::BilinearForm::assemble()). Elements which are
+ * not stored are zero.
+ *
+ * @tparam T The datatype of the values.
+ */
+    template<typename T>
+    struct SparseMatrix {
+        /*! The number of rows. */
+        size_t rows = 0;
+        /*! The number of columns. */
+        size_t cols = 0;
+        /*!
+   * The stored values of row i are stored at the indices
+   * [rowOffsets[i], rowOffsets[i + 1]) of columnIndices and values. Has
+   * rows + 1 elements.
+   */
+        std::vector<size_t> rowOffsets;
+        /*! The column indices of the stored values, ascending within a row. */
+        std::vector<size_t> columnIndices;
+        /*! The stored values. */
+        std::vector<T> values;
+
+        /*!
+   * Returns the number of stored values.
+   *
+   * @returns The number of stored values.
+   */
+        size_t nonZeros() const { return values.size(); };
+
+        /*!
+   * Returns the element in row i and column j.
+   *
+   * @param i The row index.
+   * @param j The column index.
+   * @throws BSplineException If the access is out of bounds.
+   * @returns The element, zero if it is not stored.
+   */
+        T at(size_t i, size_t j) const {
+            if (i >= rows || j >= cols) {
+                throw BSplineException(ErrorCode::INVALID_ACCESS);
+            }
+            const auto begin = columnIndices.begin() + rowOffsets[i];
+            const auto end = columnIndices.begin() + rowOffsets[i + 1];
+            const auto it = std::lower_bound(begin, end, j);
+            if (it == end || *it != j) return static_cast<T>(0);
+            return values[std::distance(columnIndices.begin(), it)];
+        }
+    };
+
+}// namespace bspline
+#endif// BSPLINE_SPARSEMATRIX_H
@@ -29,6 +29,7 @@
 
 #include <bspline/exceptions/BSplineException.h>
 #include <bspline/internal/misc.h>
+#include <bspline/internal/simd.h>
 #include <bspline/support/Support.h>
 
 #include <algorithm>
@@ -45,6 +46,91 @@ namespace bspline {
     using namespace support;
     using namespace bspline::exceptions;
 
+#ifndef BSPLINE_DOXYGEN_IGNORE
+    namespace internal {
+
+        /*!
+   * Evaluates the polynomials with the given coefficients on the intervals of a
+   * support at all points in the range [xBegin, xEnd) and writes the results to
+   * the range beginning at out. See Spline::evaluate(InputIt, InputIt,
+   * OutputIt).
+   *
+   * @param support The support.
+   * @param coefficients The coefficients of the intervals of the support,
+   * indexable by the relative interval index.
+   * @param xBegin Forward iterator referencing the first point.
+   * @param xEnd Forward iterator referencing the end of the points.
+   * @param out Output iterator the values are written to.
+   * @returns The output iterator pointing behind the last value written.
+   */
+        template<typename T, typename Coefficients, typename InputIt, typename OutputIt>
+        OutputIt evaluatePoints(const Support<T> &support, const Coefficients &coefficients,
+                                InputIt xBegin, InputIt xEnd, OutputIt out) {
+            static const T ZERO = static_cast<T>(0);
+
+            if (!std::is_sorted(xBegin, xEnd)) {
+                for (auto it = xBegin; it != xEnd; it++, out++) {
+                    const auto intervalIndex = support.findInterval(*it);
+                    *out = intervalIndex ? evaluateInterval(*it, coefficients[*intervalIndex],
+                                                            support.intervalMidpoint(*intervalIndex))
+                                         : ZERO;
+                }
+                return out;
+            }
+
+            auto it = xBegin;
+            if (support.containsIntervals()) {
+                const T &front = support.front();
+                const T &back = support.back();
+
+                // Points left of the support.
+                for (; it != xEnd && *it < front; it++, out++) {
+                    *out = ZERO;
+                }
+
+                size_t intervalIndex = 0;
+                T xm = support.intervalMidpoint(0);
+
+                while (it != xEnd && *it <= back) {
+                    if (*it > support[intervalIndex + 1]) {
+                        // Steps to the next interval are resolved directly, larger
+                        // jumps by the lookup of the grid.
+                        intervalIndex = (*it > support[intervalIndex + 2])
+                                                ? support.findInterval(*it).value()
+                                                : intervalIndex + 1;
+                        xm = support.intervalMidpoint(intervalIndex);
+                    }
+
+                    const auto &coeffs = coefficients[intervalIndex];
+                    if constexpr (has_simd_kernel_v<T>) {
+                        // Collect the points within the current interval and
+                        // evaluate them using the vectorized kernel.
+                        const T &intervalEnd = support[intervalIndex + 1];
+                        std::array<T, SIMD_BATCH_SIZE> xs;
+                        std::array<T, SIMD_BATCH_SIZE> values;
+                        size_t n = 0;
+                        for (; it != xEnd && n < xs.size() && *it <= intervalEnd; it++) {
+                            xs[n++] = *it;
+                        }
+                        evaluateIntervalBatch(xs.data(), n, coeffs, xm, values.data());
+                        out = std::copy(values.begin(), values.begin() + n, out);
+                    } else {
+                        *out = evaluateInterval(*it, coeffs, xm);
+                        it++;
+                        out++;
+                    }
+                }
+            }
+
+            // Points right of the support.
+            for (; it != xEnd; it++, out++) {
+                *out = ZERO;
+            }
+            return out;
+        }
+    }// namespace internal
+#endif// BSPLINE_DOXYGEN_IGNORE
+
     /*!
  * Spline class representing spline of datatype T and order order.
  * The coefficients of the spline are defined with respect to the center point
@@ -55,32 +141,50 @@ namespace bspline {
  */
     template<typename T, size_t order>
     class Spline final {
+    public:
+        /*!
+   * Vector type holding the polynomial coefficients of all intervals.
+   */
+        using coefficients_type = std::vector<std::array<T, order + 1>>;
+
     private:
         /*! Number of coefficients per interval. */
         static constexpr size_t ARRAY_SIZE = order + 1;
         /*! The support of this spline. */
         Support<T> _support;
         /*! Coefficients of the polynomials on each interval. */
-        std::vector<std::array<T, ARRAY_SIZE>> _coefficients;
+        coefficients_type _coefficients;
 
         /*!
-   * Finds the interval in which x lies by binary search. Used during the
-   * evaluation of the spline.
+   * Finds the interval in which x lies. Used during the evaluation of the
+   * spline. On grids with equally spaced points, the interval is determined by
+   * index arithmetic, otherwise by binary search.
    *
    * @param x Point, whose interval will be searched.
    * @return The index corresponding to the beginning of the interval which
-   * contains x or -1 if x is not part of the spline's support.
+   * contains x or std::nullopt if x is not part of the spline's support.
    */
         std::optional<size_t> findInterval(const T &x) const {
-            if (_support.size() < 2 || x > _support.back() || x < _support.front())
-                return std::nullopt;// x is not part of the spline's support
-
-            const auto begin = _support.begin();
-            const auto it = std::lower_bound(begin, _support.end(), x);
+            return _support.findInterval(x);
+        };
 
-            // Type of intervalEndIndex is signed.
-            const auto intervalEndIndex = std::distance(begin, it);
-            return std::max<decltype(intervalEndIndex)>(0, intervalEndIndex - 1);
+        /*!
+   * Determines the interval of x during a walk along the support in ascending
+   * order. Same convention as findInterval(): An interval contains its right
+   * boundary. Steps to the next interval are resolved directly, larger jumps
+   * by the lookup of the grid.
+   *
+   * @param x Point, whose interval will be searched. Must lie within the
+   * support and right of the interval intervalIndex.
+   * @param intervalIndex The index of the current interval.
+   * @return The index corresponding to the beginning of the interval which
+   * contains x.
+   */
+        size_t nextInterval(const T &x, size_t intervalIndex) const {
+            if (x > _support[intervalIndex + 2]) {
+                return findInterval(x).value();
+            }
+            return intervalIndex + 1;
         };
 
         /**
@@ -93,7 +197,7 @@ namespace bspline {
    */
         void checkValidity(
                 const Support<T> &support,
-                const std::vector<std::array<T, ARRAY_SIZE>> &coefficients) const {
+                const coefficients_type &coefficients) const {
             const bool isValid =
                     (!support.containsIntervals() && coefficients.size() == 0) ||
                     (support.size() >= 2 &&
@@ -115,13 +219,118 @@ namespace bspline {
    * spline is defined.
    * @param coefficients Polynomial coefficients on each of the intervals.
    */
-        void setData(Support<T> support,
-                     std::vector<std::array<T, ARRAY_SIZE>> coefficients) {
+        void setData(Support<T> support, coefficients_type coefficients) {
             checkValidity(support, coefficients);
             _support = std::move(support);
             _coefficients = std::move(coefficients);
         };
 
+        /*!
+   * Adds spline a to (or subtracts it from) this spline in-place. The
+   * coefficients are only reallocated if the support of a is not contained in
+   * the support of this spline, in which case the support is extended to the
+   * union of both supports.
+   *
+   * @param a Spline to be added or subtracted.
+   * @param subtract True if a is to be subtracted.
+   * @tparam ordera Order of spline a. Must not exceed the order of this spline.
+   * @throws BSplineException If the two splines are defined on different grids.
+   */
+        template<size_t ordera>
+        void accumulate(const Spline<T, ordera> &a, bool subtract) {
+            static_assert(ordera <= order);
+            const Support<T> &aSupport = a.getSupport();
+            if (!_support.hasSameGrid(aSupport)) {
+                throw BSplineException(ErrorCode::DIFFERING_GRIDS);
+            }
+            if (aSupport.empty()) return;
+
+            // Intervals outside of [keptBegin, keptEnd) are not part of the
+            // previous support, their coefficients are assigned rather than added.
+            size_t keptBegin = 0;
+            size_t keptEnd = _coefficients.size();
+            if (_support.empty() || aSupport.getStartIndex() < _support.getStartIndex() ||
+                aSupport.getEndIndex() > _support.getEndIndex()) {
+                Support<T> newSupport = _support.calcUnion(aSupport);
+                keptBegin = _support.empty()
+                                    ? 0
+                                    : _support.getStartIndex() - newSupport.getStartIndex();
+                keptEnd = keptBegin + _coefficients.size();
+
+                const auto zero = internal::make_array<T, order + 1>(static_cast<T>(0));
+                _coefficients.reserve(newSupport.numberOfIntervals());
+                _coefficients.insert(_coefficients.begin(), keptBegin, zero);
+                _coefficients.resize(newSupport.numberOfIntervals(), zero);
+                _support = std::move(newSupport);
+            }
+
+            const size_t offset = aSupport.getStartIndex() - _support.getStartIndex();
+            const auto &aCoefficients = a.getCoefficients();
+            for (size_t i = 0; i < aCoefficients.size(); i++) {
+                const size_t index = offset + i;
+                auto &coeffs = _coefficients[index];
+                if (index < keptBegin || index >= keptEnd) {
+                    for (size_t j = 0; j <= ordera; j++) {
+                        coeffs[j] = subtract ? -aCoefficients[i][j] : aCoefficients[i][j];
+                    }
+                } else if (subtract) {
+                    for (size_t j = 0; j <= ordera; j++) coeffs[j] -= aCoefficients[i][j];
+                } else {
+                    for (size_t j = 0; j <= ordera; j++) coeffs[j] += aCoefficients[i][j];
+                }
+            }
+        }
+
+        /*!
+   * Calculates the sum or difference of this spline and spline a on the union
+   * of both supports.
+   *
+   * @param a The second spline.
+   * @param subtract True if the difference is to be calculated.
+   * @tparam ordera Order of spline a.
+   * @throws BSplineException If the two splines are defined on different grids.
+   * @returns A new spline representing the sum or difference.
+   */
+        template<size_t ordera>
+        Spline<T, std::max(order, ordera)> combine(const Spline<T, ordera> &a,
+                                                  bool subtract) const {
+            static constexpr size_t NEW_ORDER = std::max(order, ordera);
+            static constexpr size_t NEW_ARRAY_SIZE = NEW_ORDER + 1;
+
+            // Will also check whether the two grids are equivalent.
+            Support newSupport = _support.calcUnion(a.getSupport());
+            const size_t nintervals = newSupport.numberOfIntervals();
+
+            typename Spline<T, NEW_ORDER>::coefficients_type ncoefficients(
+                    nintervals, internal::make_array<T, NEW_ARRAY_SIZE>(static_cast<T>(0)));
+
+            for (size_t i = 0; i < nintervals; i++) {
+                const auto absIndex = newSupport.absoluteFromRelative(i);
+                const auto thisRelIndex = _support.intervalIndexFromAbsolute(absIndex);
+                const auto aRelIndex = a.getSupport().intervalIndexFromAbsolute(absIndex);
+                auto &coeffs = ncoefficients[i];
+
+                if (thisRelIndex) {
+                    std::copy(_coefficients[*thisRelIndex].begin(),
+                              _coefficients[*thisRelIndex].end(), coeffs.begin());
+                }
+                if (aRelIndex) {
+                    const auto &aCoeffs = a.getCoefficients()[*aRelIndex];
+                    for (size_t j = 0; j <= ordera; j++) {
+                        if (!thisRelIndex) {
+                            coeffs[j] = subtract ? -aCoeffs[j] : aCoeffs[j];
+                        } else if (subtract) {
+                            coeffs[j] -= aCoeffs[j];
+                        } else {
+                            coeffs[j] += aCoeffs[j];
+                        }
+                    }
+                }
+            }
+            return Spline<T, NEW_ORDER>(std::move(newSupport),
+                                        std::move(ncoefficients));
+        }
+
     public:
         /*!
    * Provides acces to the data type T of the spline.
@@ -139,8 +348,7 @@ namespace bspline {
    * @param support The spline's support.
    * @param coefficients Polynomial coefficients of the spline on each interval.
    */
-        Spline(Support<T> support,
-               std::vector<std::array<T, ARRAY_SIZE>> coefficients)
+        Spline(Support<T> support, coefficients_type coefficients)
                 : _support(std::move(support)), _coefficients(std::move(coefficients)) {
             checkValidity(_support, _coefficients);
         };
@@ -164,12 +372,30 @@ namespace bspline {
         /*!
    * Returns the polynomial coefficients of the spline for each interval.
    */
-        const std::vector<std::array<T, ARRAY_SIZE>> &getCoefficients()
-        const noexcept {
+        const coefficients_type &getCoefficients() const noexcept {
             DURING_TEST_CHECK_VALIDITY();
             return _coefficients;
         };
 
+        /*!
+   * Replaces the polynomial coefficients of each interval by the result of f.
+   * The support of the spline is not changed.
+   *
+   * @param f Callable invoked as f(coefficients, intervalIndex), where
+   * intervalIndex is the index of the interval with respect to the global grid,
+   * returning the new coefficients of the interval.
+   * @tparam F The type of the callable.
+   * @returns A reference to this spline.
+   */
+        template<typename F>
+        Spline<T, order> &transformCoefficients(const F &f) {
+            DURING_TEST_CHECK_VALIDITY();
+            for (size_t i = 0; i < _coefficients.size(); i++) {
+                _coefficients[i] = f(_coefficients[i], _support.absoluteFromRelative(i));
+            }
+            return *this;
+        }
+
         /*!
    * Evaluates the spline at point x.
    *
@@ -183,12 +409,180 @@ namespace bspline {
 
             if (!intervalIndex) return static_cast<T>(0);
 
-            const T xm = (_support[*intervalIndex + 1] + _support[*intervalIndex]) /
-                         static_cast<T>(2);
+            const T &xm = _support.intervalMidpoint(*intervalIndex);
+
+            return internal::evaluateInterval(x, _coefficients[*intervalIndex], xm);
+        };
+
+        /*!
+   * Evaluates the spline and its first m derivatives at point x. Requires a
+   * single interval lookup and no transformation of the spline.
+   *
+   * @param x Point at which to evaluate the spline. If x is outside of the
+   * support of the spline, zeros are returned.
+   * @tparam m The number of derivatives to evaluate.
+   * @returns The array holding the value of the spline and its first m
+   * derivatives at point x.
+   */
+        template<size_t m>
+        std::array<T, m + 1> evaluateDerivatives(const T &x) const {
+            DURING_TEST_CHECK_VALIDITY();
+            const auto intervalIndex = findInterval(x);
+
+            if (!intervalIndex) {
+                std::array<T, m + 1> ret;
+                ret.fill(static_cast<T>(0));
+                return ret;
+            }
+
+            const T &xm = _support.intervalMidpoint(*intervalIndex);
+
+            return internal::evaluateIntervalDerivatives<m>(
+                    x, _coefficients[*intervalIndex], xm);
+        }
+
+        /*!
+   * Evaluates the spline at point x, where x is known to lie in the interval of
+   * the global grid beginning at the grid point gridIntervalIndex (as returned
+   * by Grid::findInterval()). Saves the interval lookup, if several splines
+   * defined on the same grid are evaluated at the same point.
+   *
+   * @param x Point at which to evaluate the spline.
+   * @param gridIntervalIndex Index of the interval of the global grid which
+   * contains x.
+   * @returns The value of the spline at point x.
+   */
+        T evaluateInGridInterval(const T &x, size_t gridIntervalIndex) const {
+            DURING_TEST_CHECK_VALIDITY();
+            auto intervalIndex = _support.intervalIndexFromAbsolute(gridIntervalIndex);
+
+            if (!intervalIndex) {
+                // If x coincides with the beginning of the support, it is part of the
+                // preceding interval of the grid, but part of the support as well.
+                if (!_support.containsIntervals() || x != _support.front()) {
+                    return static_cast<T>(0);
+                }
+                intervalIndex = 0;
+            }
+
+            const T &xm = _support.intervalMidpoint(*intervalIndex);
 
             return internal::evaluateInterval(x, _coefficients[*intervalIndex], xm);
         };
 
+        /*!
+   * Evaluates the spline at all points in the range [xBegin, xEnd) and writes
+   * the results to the range beginning at out. If the points are sorted in
+   * ascending order, the intervals are located by a single walk along the
+   * support instead of one binary search per point and, for float and double,
+   * the points within one interval are evaluated by a vectorized kernel.
+   * Unsorted points are evaluated one by one via operator().
+   *
+   * @param xBegin Forward iterator referencing the first point.
+   * @param xEnd Forward iterator referencing the end of the points.
+   * @param out Output iterator the values of the spline are written to.
+   * @tparam InputIt Forward iterator type referencing values of type T.
+   * @tparam OutputIt Output iterator type accepting values of type T.
+   * @returns The output iterator pointing behind the last value written.
+   */
+        template<typename InputIt, typename OutputIt>
+        OutputIt evaluate(InputIt xBegin, InputIt xEnd, OutputIt out) const {
+            DURING_TEST_CHECK_VALIDITY();
+            return internal::evaluatePoints(_support, _coefficients, xBegin, xEnd, out);
+        }
+
+        /*!
+   * Evaluates the spline at all points of the collection xs. See
+   * evaluate(InputIt, InputIt, OutputIt).
+   *
+   * @param xs The points at which to evaluate the spline. Must provide begin()
+   * and end() forward iterators.
+   * @tparam XCollection The type of the collection of points.
+   * @returns The values of the spline at the points xs.
+   */
+        template<typename XCollection>
+        std::vector<T> evaluate(const XCollection &xs) const {
+            std::vector<T> ret(std::distance(xs.begin(), xs.end()));
+            evaluate(xs.begin(), xs.end(), ret.begin());
+            return ret;
+        }
+
+        /*!
+   * Evaluates the spline and its first m derivatives at all points in the
+   * range [xBegin, xEnd) and writes the results to the range beginning at out.
+   * As for evaluate(InputIt, InputIt, OutputIt), sorted points are processed by
+   * a single walk along the support.
+   *
+   * @param xBegin Forward iterator referencing the first point.
+   * @param xEnd Forward iterator referencing the end of the points.
+   * @param out Output iterator the values are written to.
+   * @tparam m The number of derivatives to evaluate.
+   * @tparam InputIt Forward iterator type referencing values of type T.
+   * @tparam OutputIt Output iterator type accepting values of type
+   * std::array<T, m + 1>.
+   * @returns The output iterator pointing behind the last value written.
+   */
+        template<size_t m, typename InputIt, typename OutputIt>
+        OutputIt evaluateDerivatives(InputIt xBegin, InputIt xEnd,
+                                     OutputIt out) const {
+            DURING_TEST_CHECK_VALIDITY();
+            std::array<T, m + 1> zeros;
+            zeros.fill(static_cast<T>(0));
+
+            if (!std::is_sorted(xBegin, xEnd)) {
+                for (auto it = xBegin; it != xEnd; it++, out++) {
+                    *out = evaluateDerivatives<m>(*it);
+                }
+                return out;
+            }
+
+            auto it = xBegin;
+            if (_support.containsIntervals()) {
+                // Points left of the support.
+                for (; it != xEnd && *it < _support.front(); it++, out++) {
+                    *out = zeros;
+                }
+
+                size_t intervalIndex = 0;
+                T xm = _support.intervalMidpoint(0);
+
+                for (; it != xEnd && *it <= _support.back(); it++, out++) {
+                    if (*it > _support[intervalIndex + 1]) {
+                        intervalIndex = nextInterval(*it, intervalIndex);
+                        xm = _support.intervalMidpoint(intervalIndex);
+                    }
+                    *out = internal::evaluateIntervalDerivatives<m>(
+                            *it, _coefficients[intervalIndex], xm);
+                }
+            }
+
+            // Points right of the support.
+            for (; it != xEnd; it++, out++) {
+                *out = zeros;
+            }
+            return out;
+        }
+
+        /*!
+   * Evaluates the spline and its first m derivatives at all points of the
+   * collection xs. See evaluateDerivatives(InputIt, InputIt, OutputIt).
+   *
+   * @param xs The points at which to evaluate the spline. Must provide begin()
+   * and end() forward iterators.
+   * @tparam m The number of derivatives to evaluate.
+   * @tparam XCollection The type of the collection of points.
+   * @returns The values of the spline and its first m derivatives at the points
+   * xs.
+   */
+        template<size_t m, typename XCollection>
+        std::vector<std::array<T, m + 1>> evaluateDerivatives(
+                const XCollection &xs) const {
+            std::vector<std::array<T, m + 1>> ret(
+                    std::distance(xs.begin(), xs.end()));
+            evaluateDerivatives<m>(xs.begin(), xs.end(), ret.begin());
+            return ret;
+        }
+
         /*!
    * Returns the beginning of the support of this spline. If the spline is
    * empty, an exception is thrown.
@@ -257,28 +651,50 @@ namespace bspline {
    * @param d Scalar by which to divide this spline.
    * @returns A new, scaled spline.
    */
-        Spline<T, order> operator/(const T &d) const {
+        Spline<T, order> operator/(const T &d) const & {
             DURING_TEST_CHECK_VALIDITY();
             return (*this) * (static_cast<T>(1) / d);
         };
 
+        /*!
+   * Scalar-division operator for a temporary spline, which is scaled in-place
+   * instead of allocating new coefficients.
+   *
+   * @param d Scalar by which to divide this spline.
+   * @returns The scaled spline.
+   */
+        Spline<T, order> operator/(const T &d) && {
+            DURING_TEST_CHECK_VALIDITY();
+            (*this) /= d;
+            return std::move(*this);
+        };
+
         /*!
    * Scalar-multiplication operator. Multiplies this spline with the scalar d.
    *
    * @param d Scalar by which to multiply this spline.
    * @returns A new, scaled spline.
    */
-        Spline<T, order> operator*(const T &d) const {
+        Spline<T, order> operator*(const T &d) const & {
             DURING_TEST_CHECK_VALIDITY();
             Spline<T, order> ret(*this);
-            for (auto &cs: ret._coefficients) {
-                for (auto &c: cs) {
-                    c *= d;
-                }
-            }
+            ret *= d;
             return ret;
         };
 
+        /*!
+   * Scalar-multiplication operator for a temporary spline, which is scaled
+   * in-place instead of allocating new coefficients.
+   *
+   * @param d Scalar by which to multiply this spline.
+   * @returns The scaled spline.
+   */
+        Spline<T, order> operator*(const T &d) && {
+            DURING_TEST_CHECK_VALIDITY();
+            (*this) *= d;
+            return std::move(*this);
+        };
+
         /*!
    * In-place scalar-multiplication operator. Multiplies this spline with the
    * scalar d in-place.
@@ -313,11 +729,20 @@ namespace bspline {
    * Unary minus operator.
    * @returns A new, scaled spline.
    */
-        Spline<T, order> operator-() const {
+        Spline<T, order> operator-() const & {
             DURING_TEST_CHECK_VALIDITY();
             return (*this) * static_cast<T>(-1);
         };
 
+        /*!
+   * Unary minus operator for a temporary spline, which is negated in-place.
+   * @returns The negated spline.
+   */
+        Spline<T, order> operator-() && {
+            DURING_TEST_CHECK_VALIDITY();
+            return std::move(*this) * static_cast<T>(-1);
+        };
+
         /*!
    * Copy assign of spline to this spline object. The operation is only well
    * defined if the order of the spline to be assigned is lower than or equal to
@@ -337,9 +762,8 @@ namespace bspline {
                     "The assignment operator is only defined if the order of the rhs "
                     "spline is lower than or equal to that of the lhs spline.");
 
-            std::vector<std::array<T, ARRAY_SIZE>> ncoefficients(
-                    a.getCoefficients().size(),
-                    internal::make_array<T, ARRAY_SIZE>(static_cast<T>(0)));
+            coefficients_type ncoefficients(a.getCoefficients().size(),
+                                            internal::make_array<T, ARRAY_SIZE>(static_cast<T>(0)));
             for (size_t i = 0; i < a.getCoefficients().size(); i++) {
                 const auto &coeffsi = a.getCoefficients()[i];
                 auto &ncoeffsi = ncoefficients[i];
@@ -371,7 +795,7 @@ namespace bspline {
             if (nintervals == 0)
                 return Spline<T, NEW_ORDER>(std::move(newSupport), {});// No overlap
 
-            std::vector<std::array<T, NEW_ARRAY_SIZE>> newCoefficients(
+            typename Spline<T, NEW_ORDER>::coefficients_type newCoefficients(
                     nintervals, internal::make_array<T, NEW_ARRAY_SIZE>(static_cast<T>(0)));
 
             for (size_t i = 0; i < nintervals; i++) {
@@ -395,7 +819,8 @@ namespace bspline {
         }
 
         /*!
-   * Addition operator. Adds spline a to this spline.
+   * Addition operator. Adds spline a to this spline. Always allocates the
+   * coefficients of the result, see the overload for temporaries.
    *
    * @param a Spline to be added.
    * @tparam ordera Order of spline a.
@@ -404,46 +829,43 @@ namespace bspline {
    */
         template<size_t ordera>
         Spline<T, std::max(order, ordera)> operator+(
-                const Spline<T, ordera> &a) const {
+                const Spline<T, ordera> &a) const & {
             DURING_TEST_CHECK_VALIDITY();
-            static constexpr size_t NEW_ORDER = std::max(order, ordera);
-            static constexpr size_t NEW_ARRAY_SIZE = NEW_ORDER + 1;
-
-            // Will also check whether the two grids are equivalent.
-            Support newSupport = _support.calcUnion(a.getSupport());
-            const size_t nintervals = newSupport.numberOfIntervals();
-
-            std::vector<std::array<T, NEW_ARRAY_SIZE>> ncoefficients(nintervals);
-
-            for (size_t i = 0; i < nintervals; i++) {
-                const auto absIndex = newSupport.absoluteFromRelative(i);
-                const auto thisRelIndex = _support.intervalIndexFromAbsolute(absIndex);
-                const auto aRelIndex = a.getSupport().intervalIndexFromAbsolute(absIndex);
+            return combine(a, false);
+        }
 
-                if (thisRelIndex && !aRelIndex) {
-                    ncoefficients[i] =
-                            internal::changearraysize<T, order + 1, NEW_ARRAY_SIZE>(
-                                    _coefficients[*thisRelIndex]);
-                } else if (aRelIndex && !thisRelIndex) {
-                    ncoefficients[i] =
-                            internal::changearraysize<T, ordera + 1, NEW_ARRAY_SIZE>(
-                                    a.getCoefficients()[*aRelIndex]);
-                } else if (thisRelIndex && aRelIndex) {
-                    ncoefficients[i] = internal::add<T, ordera + 1, order + 1>(
-                            a.getCoefficients()[*aRelIndex], _coefficients[*thisRelIndex]);
-                } else {
-                    ncoefficients[i] =
-                            internal::make_array<T, NEW_ARRAY_SIZE>(static_cast<T>(0));
-                }
+        /*!
+   * Addition operator for a temporary spline. If the order of spline a does not
+   * exceed the order of this spline, a is added in-place. The coefficients are
+   * then only reallocated if the support of a is not contained in the support
+   * of this spline.
+   *
+   * Only chains starting from a temporary avoid allocations. In a + b + c with
+   * a named spline a, a + b allocates a new spline and only + c is performed
+   * in-place, which reallocates as well if c extends the support of a + b. To
+   * accumulate into a without copying, use std::move(a) + b + c or a += b.
+   *
+   * @param a Spline to be added.
+   * @tparam ordera Order of spline a.
+   * @throws BSplineException If the two splines are defined on different grids.
+   * @returns The spline representing the sum of this spline and spline a.
+   */
+        template<size_t ordera>
+        Spline<T, std::max(order, ordera)> operator+(const Spline<T, ordera> &a) && {
+            DURING_TEST_CHECK_VALIDITY();
+            if constexpr (ordera <= order) {
+                accumulate(a, false);
+                return std::move(*this);
+            } else {
+                return combine(a, false);
             }
-            return Spline<T, NEW_ORDER>(std::move(newSupport),
-                                        std::move(ncoefficients));
         }
 
         /*!
    * In-place addition operator. Adds spline a to this spline. The operation is
    * only well defined if the order of spline a is lower than or equal to the
-   * order of this spline object.
+   * order of this spline object. The coefficients are only reallocated if the
+   * support of spline a is not contained in the support of this spline.
    *
    * @param a Spline to be added.
    * @tparam ordera Order of spline a.
@@ -457,14 +879,16 @@ namespace bspline {
                     ordera <= order,
                     "The operators += and -= are only defined if the order of the rhs "
                     "spline is lower than or equal to that of the lhs spline.");
-            (*this) = (*this) + a;
+            accumulate(a, false);
             return *this;
         }
 
         /*!
    * Binary in-place subtraction operator. Subtracts spline a from this spline.
    * The operation is only well defined if the order of the spline to be
-   * subtracted is lower than or equal to the order of this spline object.
+   * subtracted is lower than or equal to the order of this spline object. The
+   * coefficients are only reallocated if the support of spline a is not
+   * contained in the support of this spline.
    *
    * @param a Spline to be subtracted.
    * @tparam ordera Order of spline a.
@@ -473,12 +897,18 @@ namespace bspline {
    */
         template<size_t ordera>
         Spline<T, order> &operator-=(const Spline<T, ordera> &a) {
-            (*this) += (static_cast<T>(-1) * a);
+            DURING_TEST_CHECK_VALIDITY();
+            static_assert(
+                    ordera <= order,
+                    "The operators += and -= are only defined if the order of the rhs "
+                    "spline is lower than or equal to that of the lhs spline.");
+            accumulate(a, true);
             return *this;
         }
 
         /*!
-   * Binary subtraction operator. Subtracts spline a from this spline.
+   * Binary subtraction operator. Subtracts spline a from this spline. Always
+   * allocates the coefficients of the result, see the overload for temporaries.
    *
    * @param a Spline to be subtracted.
    * @tparam ordera Order of spline a.
@@ -488,8 +918,33 @@ namespace bspline {
    */
         template<size_t ordera>
         Spline<T, std::max(order, ordera)> operator-(
-                const Spline<T, ordera> &a) const {
-            return (*this) + (static_cast<T>(-1) * a);
+                const Spline<T, ordera> &a) const & {
+            DURING_TEST_CHECK_VALIDITY();
+            return combine(a, true);
+        }
+
+        /*!
+   * Binary subtraction operator for a temporary spline. If the order of spline
+   * a does not exceed the order of this spline, a is subtracted in-place. The
+   * coefficients are then only reallocated if the support of a is not contained
+   * in the support of this spline. As for operator+(), only chains starting from
+   * a temporary avoid allocations.
+   *
+   * @param a Spline to be subtracted.
+   * @tparam ordera Order of spline a.
+   * @throws BSplineException If the two splines are defined on different grids.
+   * @returns The spline representing the difference of this spline and spline
+   * a.
+   */
+        template<size_t ordera>
+        Spline<T, std::max(order, ordera)> operator-(const Spline<T, ordera> &a) && {
+            DURING_TEST_CHECK_VALIDITY();
+            if constexpr (ordera <= order) {
+                accumulate(a, true);
+                return std::move(*this);
+            } else {
+                return combine(a, true);
+            }
         }
 
         /*!
@@ -535,6 +990,51 @@ namespace bspline {
         return b * d;
     }
 
+    /*!
+ * Scalar-multiplication operator for a temporary spline, which is scaled
+ * in-place.
+ *
+ * @param d Scalar by which to multiply spline b.
+ * @param b Spline to be multiplied.
+ * @tparam T Datatype of the spline and the scalar.
+ * @tparam order Order of the spline.
+ * @returns The scaled spline.
+ */
+    template<typename T, size_t order>
+    inline Spline<T, order> operator*(const T &d, Spline<T, order> &&b) {
+        return std::move(b) * d;
+    }
+
+#ifndef BSPLINE_DOXYGEN_IGNORE
+    /*!
+ * Struct to check wether type is a spline. Implementation for all types that
+ * are not a Spline.
+ *
+ * @tparam S Type to check.
+ */
+    template<typename S>
+    struct is_spline : std::false_type {
+    };
+
+    /*!
+ * Struct to check wether type is a spline. Implementation for all Splines.
+ *
+ * @tparam T Data type of the spline.
+ * @tparam order Order of the spline.
+ */
+
+    template<typename T, size_t order>
+    struct is_spline<Spline<T, order>> : std::true_type {
+    };
+#endif// BSPLINE_DOXYGEN_IGNORE
+
+    /*!
+ * Indicates whether the type is a spline.
+ * @tparam S The type to check against the Spline class.
+ */
+    template<typename S>
+    inline constexpr bool is_spline_v = is_spline<S>::value;
+
     /*!
  * Calculates the linear combination of splines. Is more efficient than
  * successive scalar multiplications and spline additions.
@@ -547,7 +1047,8 @@ namespace bspline {
  * collection.
  * @param splinesEnd The iterator referencing the end of the spline collection.
  * @tparam CoeffIter An iterator referencing a coefficient of type T.
- * @tparam SplineIter An iterator referenchig a spline of type Spline<T, order>.
+ * @tparam SplineIter An iterator referencing a spline of type Spline<T, order>
+ * or SplineView<T, order>.
  * @returns The linear combination as a spline of type Spline<T, order>.
  * @throws BSplineException If the number of coefficients differs from the
  * number of splines, if the number of coefficients and splines are zero or the
@@ -592,23 +1093,25 @@ namespace bspline {
             }
         }
 
-        const auto &support0 = splinesBegin->getSupport();
+        // Copied, since iterators over views may return the support of a temporary.
+        const Support<T> support0 = splinesBegin->getSupport();
         std::optional<size_t> startIndex;
         std::optional<size_t> endIndex;
 
         // Determine the union of all the splines' supports.
         for (auto it = splinesBegin; it < splinesEnd; it++) {
-            if (!it->getSupport().hasSameGrid(support0)) {
+            const Support<T> &support = it->getSupport();
+            if (!support.hasSameGrid(support0)) {
                 throw BSplineException(ErrorCode::DIFFERING_GRIDS);
             }
 
-            if (!it->getSupport().empty()) {
-                const size_t si = it->getSupport().getStartIndex();
+            if (!support.empty()) {
+                const size_t si = support.getStartIndex();
                 if (!startIndex || si < *startIndex) {
                     startIndex = si;
                 }
 
-                const size_t ei = it->getSupport().getEndIndex();
+                const size_t ei = support.getEndIndex();
                 if (!endIndex || ei > *endIndex) {
                     endIndex = ei;
                 }
@@ -618,7 +1121,7 @@ namespace bspline {
         // Set up support and coefficients vector for the returned spline.
         Support newSupport(support0.getGrid(), startIndex.value_or(0),
                            endIndex.value_or(0));
-        std::vector<std::array<T, order + 1>> newCoefficients(
+        typename bspline::Spline<T, order>::coefficients_type newCoefficients(
                 newSupport.numberOfIntervals(),
                 internal::make_array<T, order + 1>(static_cast<T>(0)));
 
@@ -628,17 +1131,17 @@ namespace bspline {
             // Get spline and coefficient.
             const auto &spline = *splineIt;
             const T coeff = *coeffIt;
+            const Support<T> &support = spline.getSupport();
 
-            for (size_t j = 0; j < spline.getSupport().numberOfIntervals(); j++) {
+            for (size_t j = 0; j < support.numberOfIntervals(); j++) {
                 // Index of the interval relative to the global grid.
-                const size_t absoluteIndex = spline.getSupport().absoluteFromRelative(j);
+                const size_t absoluteIndex = support.absoluteFromRelative(j);
 
                 // Index of the interval relative to the newSupport.
                 const size_t newSupportIndex =
                         newSupport.intervalIndexFromAbsolute(absoluteIndex).value();
 
-                const std::array<T, order + 1> &splineCoeffs =
-                        spline.getCoefficients().at(j);
+                const std::array<T, order + 1> &splineCoeffs = spline.getCoefficients()[j];
                 std::array<T, order + 1> &newCoeffs = newCoefficients.at(newSupportIndex);
 
                 for (size_t k = 0; k < order + 1; k++) {
@@ -650,7 +1153,7 @@ namespace bspline {
             coeffIt++;
         }
 
-        return Spline(std::move(newSupport), std::move(newCoefficients));
+        return bspline::Spline<T, order>(std::move(newSupport), std::move(newCoefficients));
     }
 
     /*!
@@ -661,8 +1164,9 @@ namespace bspline {
  * @param splines The spline collection.
  * @tparam CoeffCollection A collection of coefficients of type T. Must provide
  * begin() and end() iterators.
- * @tparam SplineCollection A collection of splines of type Spline<T, order>.
- * Must provide begin() and end() iterators.
+ * @tparam SplineCollection A collection of splines of type Spline<T, order> or
+ * SplineView<T, order>, e.g. a BSplineBasis. Must provide begin() and end()
+ * iterators.
  * @returns The linear combination as a spline of type Spline<T, order>.
  * @throws BSplineException If the number of coefficients differs from the
  * number of splines, if the number of coefficients and splines are zero or the
@@ -675,35 +1179,5 @@ namespace bspline {
                                  splines.end());
     }
 
-#ifndef BSPLINE_DOXYGEN_IGNORE
-    /*!
- * Struct to check wether type is a spline. Implementation for all types that
- * are not a Spline.
- *
- * @tparam S Type to check.
- */
-    template<typename S>
-    struct is_spline : std::false_type {
-    };
-
-    /*!
- * Struct to check wether type is a spline. Implementation for all Splines.
- *
- * @tparam T Data type of the spline.
- * @tparam order Order of the spline.
- */
-
-    template<typename T, size_t order>
-    struct is_spline<Spline<T, order>> : std::true_type {
-    };
-#endif// BSPLINE_DOXYGEN_IGNORE
-
-    /*!
- * Indicates whether the type is a spline.
- * @tparam S The type to check against the Spline class.
- */
-    template<typename S>
-    inline constexpr bool is_spline_v = is_spline<S>::value;
-
 }// namespace bspline
 #endif// BSPLINE_SPLINE_H
@@ -0,0 +1,196 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_SPLINECURSOR_H
+#define BSPLINE_SPLINECURSOR_H
+
+#include <bspline/Spline.h>
+#include <bspline/SplineView.h>
+#include <bspline/exceptions/BSplineException.h>
+#include <bspline/support/GridCursor.h>
+
+#include <iterator>
+#include <vector>
+
+namespace bspline {
+    using namespace bspline::exceptions;
+
+    /*!
+ * Evaluates one or several splines defined on the same grid at (roughly)
+ * monotonically increasing or decreasing points. The cursor remembers the
+ * interval of the previous point and checks it and its neighbors before
+ * searching the grid. Evaluating several splines at the same point only
+ * requires a single lookup.
+ *
+ * The cursor only references the splines, which must outlive it.
+ *
+ * @tparam T Datatype of the splines.
+ * @tparam order Order of the splines.
+ */
+    template<typename T, size_t order>
+    class SplineCursor final {
+    private:
+        /*! The cursor on the common global grid. */
+        support::GridCursor<T> _cursor;
+        /*! Views of the splines to evaluate. */
+        std::vector<SplineView<T, order>> _splines;
+
+        /*!
+   * Returns the grid of the first spline of a range.
+   *
+   * @param splinesBegin The iterator referencing the first spline.
+   * @param splinesEnd The iterator referencing the end of the splines.
+   * @tparam SplineIter An iterator referencing a spline.
+   * @throws BSplineException If the range of splines is empty.
+   * @returns The grid of the first spline.
+   */
+        template<typename SplineIter>
+        static support::Grid<T> getFirstGrid(SplineIter splinesBegin,
+                                                     SplineIter splinesEnd) {
+            if (splinesBegin == splinesEnd) {
+                throw BSplineException(ErrorCode::MISSING_DATA,
+                                       "The number of splines may not be zero.");
+            }
+            return splinesBegin->getSupport().getGrid();
+        }
+
+    public:
+        /*!
+   * Constructs a cursor for a single spline.
+   *
+   * @param spline The spline to evaluate.
+   */
+        explicit SplineCursor(const Spline<T, order> &spline)
+                : SplineCursor(SplineView<T, order>(spline)) {};
+
+        /*!
+   * Constructs a cursor for a single spline view.
+   *
+   * @param spline The view of the spline to evaluate.
+   */
+        explicit SplineCursor(const SplineView<T, order> &spline)
+                : _cursor(spline.getSupport().getGrid()), _splines{spline} {};
+
+        /*!
+   * Constructs a cursor for a range of splines.
+   *
+   * @param splinesBegin The iterator referencing the first spline.
+   * @param splinesEnd The iterator referencing the end of the splines.
+   * @tparam SplineIter An iterator referencing a spline of type
+   * Spline<T, order> or SplineView<T, order>.
+   * @throws BSplineException If the range of splines is empty or the splines
+   * are defined on different grids.
+   */
+        template<typename SplineIter>
+        SplineCursor(SplineIter splinesBegin, SplineIter splinesEnd)
+                : _cursor(getFirstGrid(splinesBegin, splinesEnd)) {
+            for (auto it = splinesBegin; it != splinesEnd; it++) {
+                if (it->getSupport().getGrid() != _cursor.getGrid()) {
+                    throw BSplineException(ErrorCode::DIFFERING_GRIDS);
+                }
+                _splines.push_back(SplineView<T, order>(*it));
+            }
+        }
+
+        /*!
+   * Constructs a cursor for a collection of splines.
+   *
+   * @param splines The collection of splines. Must provide begin() and end()
+   * iterators.
+   * @tparam SplineCollection A collection of splines of type Spline<T, order>
+   * or SplineView<T, order>, e.g. a BSplineBasis<T, order>.
+   * @throws BSplineException If the collection is empty or the splines are
+   * defined on different grids.
+   */
+        template<typename SplineCollection>
+        explicit SplineCursor(const SplineCollection &splines)
+                : SplineCursor(splines.begin(), splines.end()) {}
+
+        /*!
+   * Returns the number of splines evaluated by this cursor.
+   *
+   * @returns The number of splines.
+   */
+        size_t size() const { return _splines.size(); };
+
+        /*!
+   * Evaluates the first (for a cursor constructed from a single spline, the
+   * only) spline at point x.
+   *
+   * @param x Point at which to evaluate the spline.
+   * @returns The value of the spline at point x.
+   */
+        T operator()(const T &x) {
+            const auto intervalIndex = _cursor.findInterval(x);
+            if (!intervalIndex) return static_cast<T>(0);
+            return _splines.front().evaluateInGridInterval(x, *intervalIndex);
+        };
+
+        /*!
+   * Evaluates all splines at point x and writes the values to out, in the order
+   * in which the splines were provided.
+   *
+   * @param x Point at which to evaluate the splines.
+   * @param out Output iterator the values of the splines are written to.
+   * @tparam OutputIt Output iterator type accepting values of type T.
+   * @returns The output iterator pointing behind the last value written.
+   */
+        template<typename OutputIt>
+        OutputIt evaluate(const T &x, OutputIt out) {
+            const auto intervalIndex = _cursor.findInterval(x);
+            for (const SplineView<T, order> &spline: _splines) {
+                *out = intervalIndex ? spline.evaluateInGridInterval(x, *intervalIndex)
+                                     : static_cast<T>(0);
+                out++;
+            }
+            return out;
+        }
+
+        /*!
+   * Evaluates all splines at point x.
+   *
+   * @param x Point at which to evaluate the splines.
+   * @returns The values of the splines, in the order in which the splines were
+   * provided.
+   */
+        std::vector<T> evaluate(const T &x) {
+            std::vector<T> ret(_splines.size());
+            evaluate(x, ret.begin());
+            return ret;
+        };
+    };
+
+    /*!
+ * Deduction guide for a cursor constructed from a single spline.
+ */
+    template<typename T, size_t order>
+    SplineCursor(const Spline<T, order> &spline) -> SplineCursor<T, order>;
+
+    /*!
+ * Deduction guide for a cursor constructed from a single spline view.
+ */
+    template<typename T, size_t order>
+    SplineCursor(const SplineView<T, order> &spline) -> SplineCursor<T, order>;
+
+    /*!
+ * Deduction guide for a cursor constructed from a range of splines.
+ */
+    template<typename SplineIter>
+    SplineCursor(SplineIter splinesBegin, SplineIter splinesEnd) -> SplineCursor<
+            typename std::iterator_traits<SplineIter>::value_type::data_type,
+            std::iterator_traits<SplineIter>::value_type::spline_order>;
+
+    /*!
+ * Deduction guide for a cursor constructed from a collection of splines.
+ */
+    template<typename SplineCollection>
+    SplineCursor(const SplineCollection &splines) -> SplineCursor<
+            typename SplineCollection::value_type::data_type,
+            SplineCollection::value_type::spline_order>;
+
+}// namespace bspline
+#endif// BSPLINE_SPLINECURSOR_H
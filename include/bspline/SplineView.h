@@ -0,0 +1,383 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_SPLINEVIEW_H
+#define BSPLINE_SPLINEVIEW_H
+
+#include <bspline/Spline.h>
+#include <bspline/exceptions/BSplineException.h>
+#include <bspline/operators/GenericOperators.h>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace bspline {
+
+    /*!
+ * Non-owning counterpart of Spline, which refers to coefficients stored in an
+ * external buffer, e.g. one buffer holding the coefficients of a whole family
+ * of splines. The coefficients are neither copied nor modified. The buffer must
+ * outlive the view. The support is stored as a pointer to the global grid and an
+ * index range, such that views can be created in bulk, e.g. by BSplineBasis,
+ * without copying the grid; the grid must outlive the view as well.
+ *
+ * @tparam T Datatype of the spline.
+ * @tparam order Order of the spline.
+ */
+    template<typename T, size_t order>
+    class SplineView final {
+    private:
+        /*! Number of coefficients per interval. */
+        static constexpr size_t ARRAY_SIZE = order + 1;
+        /*! The global grid. */
+        const Grid<T> *_grid;
+        /*! The index of the first grid point of the support. */
+        size_t _startIndex;
+        /*! The index behind the last grid point of the support. */
+        size_t _endIndex;
+        /*!
+   * The coefficients of the polynomials on each interval of the support, as
+   * stored by Spline.
+   */
+        const std::array<T, ARRAY_SIZE> *_coefficients;
+
+        /*!
+   * Finds the interval of the support in which x lies. See
+   * Support::findInterval().
+   *
+   * @param x The point to search for.
+   * @returns The index of the interval relative to the support or
+   * std::nullopt if x is not part of the support.
+   */
+        std::optional<size_t> findInterval(const T &x) const {
+            if (!containsIntervals() || x < (*_grid)[_startIndex] ||
+                x > (*_grid)[_endIndex - 1]) {
+                return std::nullopt;
+            }
+            const size_t absoluteIndex = _grid->findInterval(x).value();
+            return std::max(absoluteIndex, _startIndex) - _startIndex;
+        }
+
+    public:
+        /*!
+   * Provides acces to the data type T of the spline.
+   */
+        using data_type = T;
+
+        /*!
+   * Provides access to the order of the spline.
+   */
+        static constexpr size_t spline_order = order;
+
+        /*!
+   * Constructs a view of coefficients stored in an external buffer. The grid
+   * is referenced, not copied, such that constructing a view is as cheap as
+   * copying a few indices.
+   *
+   * @param grid The global grid. Must outlive the view.
+   * @param startIndex The index of the first grid point of the support.
+   * @param endIndex The index behind the last grid point of the support.
+   * @param coefficients Pointer to the polynomial coefficients of the first
+   * interval, followed by those of the remaining intervals of the support.
+   * @throws BSplineException If the indices do not describe a valid support of
+   * the grid, or if the support contains intervals, but no coefficients are
+   * provided.
+   */
+        SplineView(const Grid<T> &grid, size_t startIndex, size_t endIndex,
+                   const std::array<T, ARRAY_SIZE> *coefficients)
+                : _grid(&grid), _startIndex(startIndex), _endIndex(endIndex),
+                  _coefficients(coefficients) {
+            const bool isEmpty = _startIndex == 0 && _endIndex == 0;
+            if (!isEmpty && (_endIndex <= _startIndex || _endIndex > _grid->size())) {
+                throw BSplineException(ErrorCode::INCONSISTENT_DATA);
+            }
+            if (containsIntervals() && _coefficients == nullptr) {
+                throw BSplineException(ErrorCode::INCONSISTENT_DATA);
+            }
+        };
+
+        /*!
+   * Constructs a view of coefficients stored in an external buffer.
+   *
+   * @param support The spline's support. Must outlive the view.
+   * @param coefficients Pointer to the polynomial coefficients of the first
+   * interval, followed by those of the remaining support.numberOfIntervals() - 1
+   * intervals.
+   * @throws BSplineException If the support contains intervals, but no
+   * coefficients are provided.
+   */
+        SplineView(const Support<T> &support, const std::array<T, ARRAY_SIZE> *coefficients)
+                : SplineView(support.getGrid(), support.getStartIndex(), support.getEndIndex(),
+                             coefficients) {};
+
+        /*!
+   * Views referring to the grid of a temporary support would dangle.
+   */
+        SplineView(Support<T> &&support, const std::array<T, ARRAY_SIZE> *coefficients) = delete;
+
+        /*!
+   * Constructs a view of the coefficients of a spline.
+   *
+   * @param spline The spline. Must outlive the view.
+   */
+        SplineView(const Spline<T, order> &spline)
+                : SplineView(spline.getSupport(), spline.getCoefficients().data()) {};
+
+        /*!
+   * Views of temporary splines would dangle.
+   */
+        SplineView(Spline<T, order> &&spline) = delete;
+
+        /*!
+   * Returns the global grid.
+   */
+        const Grid<T> &getGrid() const noexcept { return *_grid; };
+
+        /*!
+   * Returns the index of the first grid point of the support.
+   */
+        size_t getStartIndex() const noexcept { return _startIndex; };
+
+        /*!
+   * Returns the index behind the last grid point of the support.
+   */
+        size_t getEndIndex() const noexcept { return _endIndex; };
+
+        /*!
+   * Checks whether the support contains at least one interval.
+   */
+        bool containsIntervals() const noexcept { return _endIndex > _startIndex + 1; };
+
+        /*!
+   * Returns the number of intervals of the support.
+   */
+        size_t numberOfIntervals() const noexcept {
+            return containsIntervals() ? _endIndex - _startIndex - 1 : 0;
+        };
+
+        /*!
+   * Constructs the spline's support. The view stores only the grid and the
+   * index range, such that the support is built on each call.
+   *
+   * @returns The support.
+   */
+        Support<T> getSupport() const { return Support<T>(*_grid, _startIndex, _endIndex); };
+
+        /*!
+   * Returns the polynomial coefficients of the spline for each interval.
+   *
+   * @returns Pointer to the numberOfIntervals() coefficient arrays.
+   */
+        const std::array<T, ARRAY_SIZE> *getCoefficients() const noexcept {
+            return _coefficients;
+        };
+
+        /*!
+   * Copies the viewed data into a spline.
+   *
+   * @returns The spline.
+   */
+        Spline<T, order> toSpline() const {
+            return Spline<T, order>(
+                    getSupport(), typename Spline<T, order>::coefficients_type(
+                                          _coefficients, _coefficients + numberOfIntervals()));
+        }
+
+        /*!
+   * Evaluates the spline at point x.
+   *
+   * @param x Point at which to evaluate the spline. If x is outside of the
+   * support of the spline, zero is returned.
+   * @returns The value of the spline at point x.
+   */
+        T operator()(const T &x) const {
+            const auto intervalIndex = findInterval(x);
+
+            if (!intervalIndex) return static_cast<T>(0);
+
+            const T &xm = _grid->midpoint(_startIndex + *intervalIndex);
+
+            return internal::evaluateInterval(x, _coefficients[*intervalIndex], xm);
+        };
+
+        /*!
+   * Evaluates the spline at point x, where x is known to lie in the interval of
+   * the global grid beginning at the grid point gridIntervalIndex. See
+   * Spline::evaluateInGridInterval().
+   *
+   * @param x Point at which to evaluate the spline.
+   * @param gridIntervalIndex Index of the interval of the global grid which
+   * contains x.
+   * @returns The value of the spline at point x.
+   */
+        T evaluateInGridInterval(const T &x, size_t gridIntervalIndex) const {
+            size_t absoluteIndex = gridIntervalIndex;
+
+            if (gridIntervalIndex < _startIndex || gridIntervalIndex + 1 >= _endIndex) {
+                // If x coincides with the beginning of the support, it is part of the
+                // preceding interval of the grid, but part of the support as well.
+                if (!containsIntervals() || x != (*_grid)[_startIndex]) {
+                    return static_cast<T>(0);
+                }
+                absoluteIndex = _startIndex;
+            }
+
+            const T &xm = _grid->midpoint(absoluteIndex);
+
+            return internal::evaluateInterval(x, _coefficients[absoluteIndex - _startIndex], xm);
+        };
+
+        /*!
+   * Evaluates the spline at all points in the range [xBegin, xEnd) and writes
+   * the results to the range beginning at out. See
+   * Spline::evaluate(InputIt, InputIt, OutputIt).
+   *
+   * @param xBegin Forward iterator referencing the first point.
+   * @param xEnd Forward iterator referencing the end of the points.
+   * @param out Output iterator the values of the spline are written to.
+   * @tparam InputIt Forward iterator type referencing values of type T.
+   * @tparam OutputIt Output iterator type accepting values of type T.
+   * @returns The output iterator pointing behind the last value written.
+   */
+        template<typename InputIt, typename OutputIt>
+        OutputIt evaluate(InputIt xBegin, InputIt xEnd, OutputIt out) const {
+            return internal::evaluatePoints(getSupport(), _coefficients, xBegin, xEnd, out);
+        }
+
+        /*!
+   * Evaluates the spline at all points of the collection xs. See
+   * evaluate(InputIt, InputIt, OutputIt).
+   *
+   * @param xs The points at which to evaluate the spline. Must provide begin()
+   * and end() forward iterators.
+   * @tparam XCollection The type of the collection of points.
+   * @returns The values of the spline at the points xs.
+   */
+        template<typename XCollection>
+        std::vector<T> evaluate(const XCollection &xs) const {
+            std::vector<T> ret(std::distance(xs.begin(), xs.end()));
+            evaluate(xs.begin(), xs.end(), ret.begin());
+            return ret;
+        }
+    };
+
+    /*!
+ * Deduction guide for a view of a spline.
+ */
+    template<typename T, size_t order>
+    SplineView(const Spline<T, order> &spline) -> SplineView<T, order>;
+
+    /*!
+ * Deduction guide for a view of coefficients stored in an external buffer.
+ */
+    template<typename T, size_t ARRAY_SIZE>
+    SplineView(const Support<T> &support, const std::array<T, ARRAY_SIZE> *coefficients)
+    -> SplineView<T, ARRAY_SIZE - 1>;
+
+    /*!
+ * Deduction guide for a view of coefficients stored in an external buffer,
+ * whose support is given by a grid and an index range.
+ */
+    template<typename T, size_t ARRAY_SIZE>
+    SplineView(const Grid<T> &grid, size_t startIndex, size_t endIndex,
+               const std::array<T, ARRAY_SIZE> *coefficients) -> SplineView<T, ARRAY_SIZE - 1>;
+
+#ifndef BSPLINE_DOXYGEN_IGNORE
+    /*!
+ * Struct to check wether type is a spline view. Default implementation for all
+ * types that are no spline views.
+ *
+ * @tparam S Type to check.
+ */
+    template<typename S>
+    struct is_spline_view : std::false_type {
+    };
+
+    /*!
+ * Struct to check wether type is a spline view. Implementation for all spline
+ * views.
+ *
+ * @tparam T Data type of the spline.
+ * @tparam order Order of the spline.
+ */
+    template<typename T, size_t order>
+    struct is_spline_view<SplineView<T, order>> : std::true_type {
+    };
+#endif// BSPLINE_DOXYGEN_IGNORE
+
+    /*!
+ * Indicates whether the type is a spline view.
+ * @tparam S The type to check against the SplineView class.
+ */
+    template<typename S>
+    inline constexpr bool is_spline_view_v = is_spline_view<S>::value;
+
+    /*!
+ * Indicates whether the type is a spline or a spline view, i.e. provides the
+ * support and the coefficients of a spline.
+ * @tparam S The type to check.
+ */
+    template<typename S>
+    inline constexpr bool is_spline_or_view_v = is_spline_v<S> || is_spline_view_v<S>;
+
+}// namespace bspline
+
+namespace bspline::operators {
+
+    /*!
+ * Helper method that applies an operator to a spline view. The coefficients
+ * are read from the viewed buffer, the result is a new spline.
+ *
+ * @param op The operator to apply to the spline.
+ * @param spline The view of the spline to apply the operator to.
+ * @tparam T The datatype of the input and output splines.
+ * @tparam order The order of the input spline.
+ * @tparam O The type of the operator.
+ * @returns The spline resulting from the application of this operator to the
+ * spline.
+ */
+    template<typename T, size_t order, typename O,
+            std::enable_if_t<is_operator_v<O>, bool> = true>
+    auto transformSpline(const O &op, const SplineView<T, order> &spline) {
+        constexpr size_t OUTPUT_ORDER = O::outputOrder(order);
+
+        const Support<T> support = spline.getSupport();
+        const size_t nintervals = support.numberOfIntervals();
+
+        typename Spline<T, OUTPUT_ORDER>::coefficients_type newCoefficients;
+        newCoefficients.reserve(nintervals);
+
+        for (size_t i = 0; i < nintervals; i++) {
+            const size_t absIndex = support.absoluteFromRelative(i);
+            newCoefficients.push_back(
+                    op.transform(spline.getCoefficients()[i], support.getGrid(), absIndex));
+        }
+
+        return Spline<T, OUTPUT_ORDER>(support, std::move(newCoefficients));
+    }
+
+    /*!
+ * Applies an operator to a spline view.
+ *
+ * @param o The operator.
+ * @param s The view of the spline.
+ * @tparam O The type of the operator.
+ * @tparam T The datatype of the spline.
+ * @tparam order The order of the spline.
+ * @returns The spline resulting from the application of the operator to the
+ * spline.
+ */
+    template<typename O, typename T, size_t order,
+            std::enable_if_t<is_operator_v<O>, bool> = true>
+    auto operator*(const O &o, const SplineView<T, order> &s) {
+        return transformSpline(o, s);
+    }
+}// namespace bspline::operators
+#endif// BSPLINE_SPLINEVIEW_H
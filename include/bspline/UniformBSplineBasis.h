@@ -0,0 +1,356 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_UNIFORMBSPLINEBASIS_H
+#define BSPLINE_UNIFORMBSPLINEBASIS_H
+
+#include <bspline/BSplineGenerator.h>
+#include <bspline/Spline.h>
+#include <bspline/SplineView.h>
+#include <bspline/exceptions/BSplineException.h>
+#include <bspline/internal/IndexIterator.h>
+#include <bspline/internal/StableGrid.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace bspline {
+    using namespace bspline::exceptions;
+
+    /*!
+ * The basis of BSplines on a knots vector, whose distinct knots are equally
+ * spaced and of which only the first and the last knot may be repeated. Every
+ * BSpline whose knots are all distinct is a translate of the same reference
+ * spline, of which the coefficients are stored only once. Its support is
+ * shifted by the index of the spline, the coefficients (relative to the
+ * midpoints of the intervals) being the same. Only the BSplines at the
+ * boundaries of the grid, which involve repeated knots, are stored
+ * separately. The splines are accessed as SplineView objects, such that the
+ * basis can be passed wherever a collection of splines is expected, e.g. to
+ * collocationMatrix(), SplineCursor or ParallelEvaluator::tabulate().
+ *
+ * @tparam T Datatype of the splines.
+ * @tparam order Order of the splines.
+ */
+    template<typename T, size_t order>
+    class UniformBSplineBasis final {
+    private:
+        /*! Number of coefficients per interval. */
+        static constexpr size_t ARRAY_SIZE = order + 1;
+
+        /*! The global grid, kept at a fixed address such that moves keep views valid. */
+        internal::StableGrid<T> _grid;
+        /*! The number of splines. */
+        size_t _size;
+        /*! The index of the first translate of the reference spline. */
+        size_t _interiorBegin;
+        /*! The index behind the last translate of the reference spline. */
+        size_t _interiorEnd;
+        /*!
+   * The coefficients of the reference spline, i.e. of the spline _interiorBegin,
+   * which is supported on the first order + 1 intervals of the grid. Empty if
+   * there are no translates.
+   */
+        std::vector<std::array<T, ARRAY_SIZE>> _reference;
+        /*! The index of the first grid point of the support of each boundary spline. */
+        std::vector<size_t> _startIndices;
+        /*! The index behind the last grid point of the support of each boundary spline. */
+        std::vector<size_t> _endIndices;
+        /*!
+   * The coefficients of the i-th boundary spline begin at
+   * _coefficients[_offsets[i]].
+   */
+        std::vector<size_t> _offsets;
+        /*! The coefficients of all boundary splines. */
+        std::vector<std::array<T, ARRAY_SIZE>> _coefficients;
+
+        /*!
+   * Generates the grid from the knots vector and checks that the knots
+   * describe a uniform basis.
+   *
+   * @param knots The knots vector.
+   * @param relativeTolerance The tolerance of the grid points relative to the
+   * largest absolute value of the grid.
+   * @throws BSplineException If the knots vector does not contain enough
+   * entries to generate at least one spline of order order.
+   * @throws BSplineException If the knots are not in increasing order.
+   * @throws BSplineException If a knot other than the first and the last one
+   * is repeated or the distinct knots are not equally spaced.
+   * @returns The grid.
+   */
+        static Grid<T> generateUniformGrid(const std::vector<T> &knots,
+                                           const T &relativeTolerance) {
+            if (knots.size() < order + 2) {
+                throw BSplineException(ErrorCode::UNDETERMINED,
+                                       "The knots vector contains too few elements to "
+                                       "generate BSplines of the requested order.");
+            } else if (!std::is_sorted(knots.begin(), knots.end())) {
+                throw BSplineException(ErrorCode::UNDETERMINED);
+            }
+
+            std::vector<T> points(knots);
+            points.erase(std::unique(points.begin(), points.end()), points.end());
+            const auto repeated = [&knots](const T &knot) {
+                const auto range = std::equal_range(knots.begin(), knots.end(), knot);
+                return static_cast<size_t>(range.second - range.first) - 1;
+            };
+            if (points.size() < 2 ||
+                knots.size() != points.size() + repeated(knots.front()) + repeated(knots.back())) {
+                throw BSplineException(ErrorCode::INCONSISTENT_DATA,
+                                       "Only the first and the last knot may be repeated.");
+            }
+
+            const size_t n = points.size();
+            const T step = (points.back() - points.front()) / static_cast<T>(n - 1);
+            const T scale = std::max({points.front(), -points.front(), points.back(), -points.back()});
+            const T tolerance = relativeTolerance * scale;
+            for (size_t i = 1; i + 1 < n; i++) {
+                const T deviation = points[i] - (points.front() + static_cast<T>(i) * step);
+                if (deviation > tolerance || -deviation > tolerance) {
+                    throw BSplineException(ErrorCode::INCONSISTENT_DATA,
+                                           "The knots are not equally spaced.");
+                }
+            }
+            return Grid<T>(std::move(points));
+        }
+
+        /*!
+   * Generates the BSplines [begin, end) of the knots vector, which are
+   * determined by the knots [begin, end + order + 1), and stores them as
+   * boundary splines.
+   *
+   * @param knots The knots vector.
+   * @param begin The index of the first spline.
+   * @param end The index behind the last spline.
+   */
+        void appendBoundarySplines(const std::vector<T> &knots, size_t begin, size_t end) {
+            if (begin == end) return;
+
+            // The grid of the sub-vector is a contiguous part of the global grid.
+            std::vector<T> subKnots(knots.begin() + begin, knots.begin() + end + order + 1);
+            const size_t gridOffset = _grid.get().findElement(subKnots.front());
+            for (const auto &spline: generateBSplines<order>(std::move(subKnots))) {
+                const Support<T> &support = spline.getSupport();
+                if (support.empty()) {
+                    _startIndices.push_back(0);
+                    _endIndices.push_back(0);
+                } else {
+                    _startIndices.push_back(support.getStartIndex() + gridOffset);
+                    _endIndices.push_back(support.getEndIndex() + gridOffset);
+                }
+                if (support.containsIntervals()) {
+                    const auto *coefficients = &spline.getCoefficients()[0];
+                    _coefficients.insert(_coefficients.end(), coefficients,
+                                         coefficients + support.numberOfIntervals());
+                }
+                _offsets.push_back(_coefficients.size());
+            }
+        }
+
+        /*!
+   * Returns a view of the i-th boundary spline.
+   *
+   * @param i The index of the spline among the boundary splines.
+   * @returns The view of the spline.
+   */
+        SplineView<T, order> boundarySpline(size_t i) const {
+            return SplineView<T, order>(_grid.get(), _startIndices[i], _endIndices[i],
+                                        _coefficients.data() + _offsets[i]);
+        }
+
+    public:
+        /*!
+   * The type of the elements of the basis.
+   */
+        using value_type = SplineView<T, order>;
+
+        /*!
+   * Random access iterator referencing the splines of a basis. Dereferencing
+   * yields a SplineView by value.
+   */
+        using const_iterator = internal::IndexIterator<UniformBSplineBasis>;
+
+        /*!
+   * Provides acces to the data type T of the splines.
+   */
+        using data_type = T;
+
+        /*!
+   * Provides access to the order of the splines.
+   */
+        static constexpr size_t spline_order = order;
+
+        /*!
+   * Generates the basis of BSplines on a uniform knots vector.
+   *
+   * @param knots The knots vector. The distinct knots must be equally spaced,
+   * only the first and the last knot may be repeated.
+   * @param relativeTolerance The maximal deviation of the distinct knots from
+   * equally spaced positions, relative to the largest absolute value of the
+   * knots.
+   * @throws BSplineException If the knots vector does not contain enough
+   * entries to generate at least one spline of order order.
+   * @throws BSplineException If the knots are not in increasing order.
+   * @throws BSplineException If a knot other than the first and the last one
+   * is repeated or the distinct knots are not equally spaced.
+   */
+        explicit UniformBSplineBasis(
+                const std::vector<T> &knots,
+                const T &relativeTolerance = static_cast<T>(1000) * std::numeric_limits<T>::epsilon())
+                : _grid(generateUniformGrid(knots, relativeTolerance)),
+                  _size(knots.size() - order - 1), _offsets{0} {
+            // Spline i is a translate of the reference spline, if its knots
+            // [i, i + order + 1] are distinct, i.e. if it starts at the last
+            // occurrence of the first knot or behind it and ends at the first
+            // occurrence of the last knot or before it.
+            const size_t firstKnotCount =
+                    std::upper_bound(knots.begin(), knots.end(), knots.front()) - knots.begin();
+            const size_t lastKnotIndex =
+                    std::lower_bound(knots.begin(), knots.end(), knots.back()) - knots.begin();
+            _interiorBegin = std::min(firstKnotCount - 1, _size);
+            _interiorEnd = (lastKnotIndex > order) ? std::min(lastKnotIndex - order, _size) : 0;
+            _interiorEnd = std::max(_interiorEnd, _interiorBegin);
+
+            if (_interiorEnd > _interiorBegin) {
+                const std::vector<T> referenceKnots(knots.begin() + _interiorBegin,
+                                                    knots.begin() + _interiorBegin + order + 2);
+                const auto reference = generateBSplines<order>(referenceKnots);
+                const auto &coefficients = reference.front().getCoefficients();
+                _reference.assign(coefficients.begin(), coefficients.end());
+            }
+            appendBoundarySplines(knots, 0, _interiorBegin);
+            appendBoundarySplines(knots, _interiorEnd, _size);
+        }
+
+        /*!
+   * Returns the global grid.
+   */
+        const Grid<T> &getGrid() const noexcept { return _grid.get(); };
+
+        /*!
+   * Returns the number of splines.
+   */
+        size_t size() const noexcept { return _size; };
+
+        /*!
+   * Returns the number of splines, which are translates of the reference
+   * spline.
+   */
+        size_t numberOfTranslates() const noexcept { return _interiorEnd - _interiorBegin; };
+
+        /*!
+   * Returns the index of the first spline, which is a translate of the
+   * reference spline. The translates are the splines
+   * [firstTranslate(), firstTranslate() + numberOfTranslates()), translate
+   * firstTranslate() + t being supported on the grid intervals
+   * [t, t + order + 1).
+   */
+        size_t firstTranslate() const noexcept { return _interiorBegin; };
+
+        /*!
+   * Returns the coefficients of the reference spline, which all translates
+   * share. Empty if there are no translates.
+   */
+        const std::vector<std::array<T, ARRAY_SIZE>> &getReferenceCoefficients() const noexcept {
+            return _reference;
+        };
+
+        /*!
+   * Returns the coefficients of all boundary splines, in the order of the
+   * splines.
+   */
+        const std::vector<std::array<T, ARRAY_SIZE>> &getBoundaryCoefficients() const noexcept {
+            return _coefficients;
+        };
+
+        /*!
+   * Returns a view of the i-th spline.
+   *
+   * @param i The index of the spline. Must be smaller than size().
+   * @returns The view of the spline, which refers to the coefficients stored in
+   * this basis.
+   */
+        SplineView<T, order> operator[](size_t i) const {
+            if (i < _interiorBegin) {
+                return boundarySpline(i);
+            } else if (i < _interiorEnd) {
+                // The reference spline starts at the first grid point.
+                const size_t startIndex = i - _interiorBegin;
+                return SplineView<T, order>(_grid.get(), startIndex, startIndex + order + 2,
+                                            _reference.data());
+            } else {
+                return boundarySpline(i - numberOfTranslates());
+            }
+        };
+
+        /*!
+   * Returns a view of the i-th spline.
+   *
+   * @param i The index of the spline.
+   * @throws BSplineException If i is not smaller than size().
+   * @returns The view of the spline.
+   */
+        SplineView<T, order> at(size_t i) const {
+            if (i >= size()) {
+                throw BSplineException(ErrorCode::INVALID_ACCESS);
+            }
+            return (*this)[i];
+        };
+
+        /*!
+   * Returns the iterator referencing the first spline.
+   */
+        const_iterator begin() const { return const_iterator(this, 0); };
+
+        /*!
+   * Returns the iterator referencing the end of the splines.
+   */
+        const_iterator end() const {
+            return const_iterator(this, static_cast<std::ptrdiff_t>(size()));
+        };
+
+        /*!
+   * Copies the splines out of the basis.
+   *
+   * @returns The splines.
+   */
+        std::vector<Spline<T, order>> toSplines() const {
+            std::vector<Spline<T, order>> ret;
+            ret.reserve(size());
+            for (size_t i = 0; i < size(); i++) {
+                ret.push_back((*this)[i].toSpline());
+            }
+            return ret;
+        }
+    };
+
+    /*!
+ * Convenience method to generate the basis of BSplines on a uniform knots
+ * vector. See UniformBSplineBasis.
+ *
+ * @param knots The knots vector to generate the splines from. The distinct
+ * knots must be equally spaced, only the first and the last knot may be
+ * repeated.
+ * @tparam order The order of the BSplines to generate.
+ * @tparam T The data type of the knots vector and the generated BSplines.
+ * @throws BSplineException If the knots vector does not contain enough entries
+ * to generate at least one spline of the requested order.
+ * @throws BSplineException If the knots are not in increasing order.
+ * @throws BSplineException If the knots are not uniform.
+ * @returns The basis of all BSplines of order order defined on the knots
+ * vector.
+ */
+    template<size_t order, typename T>
+    UniformBSplineBasis<T, order> generateUniformBasis(const std::vector<T> &knots) {
+        return UniformBSplineBasis<T, order>(knots);
+    }
+
+}// namespace bspline
+#endif// BSPLINE_UNIFORMBSPLINEBASIS_H
@@ -8,9 +8,29 @@
 #ifndef BSPLINE_INTEGRATION_BILINEARFORM_H
 #define BSPLINE_INTEGRATION_BILINEARFORM_H
 
+#include <bspline/SparseMatrix.h>
 #include <bspline/Spline.h>
+#include <bspline/SplineView.h>
+#include <bspline/exceptions/BSplineException.h>
+#include <bspline/internal/StableGrid.h>
 #include <bspline/operators/GenericOperators.h>
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bspline {
+    class ParallelEvaluator;
+
+    template<typename T, size_t order>
+    class UniformBSplineBasis;
+}// namespace bspline
+
 /*!
  * Nampespace containing the integration routines. Analytical integration is
  * represented by the linear and bilinear forms. There is also code for
@@ -94,22 +114,197 @@ namespace bspline::integration {
    */
         BilinearForm() : _o1(O1{}), _o2(O2{}) {};
 
+        /*!
+   * The coefficients of a collection of splines defined on a common grid,
+   * transformed by both operators of a bilinear form on each interval of their
+   * supports. Returned by BilinearForm::transform(), it allows evaluating the
+   * bilinear form for many pairs of splines without applying the operators
+   * again. It must only be used with the bilinear form it was created by (or an
+   * identical one).
+   *
+   * @tparam T The datatype of the splines.
+   * @tparam order The order of the splines.
+   */
+        template<typename T, size_t order>
+        class TransformedSplines final {
+        private:
+            friend class BilinearForm;
+
+            /*! The coefficients of a spline on one interval. */
+            using Coefficients = std::array<T, order + 1>;
+            /*! The coefficients transformed by the first operator. */
+            using Left = decltype(std::declval<const O1 &>().transform(
+                    std::declval<const Coefficients &>(),
+                    std::declval<const support::Grid<T> &>(), size_t{0}));
+            /*! The coefficients transformed by the second operator. */
+            using Right = decltype(std::declval<const O2 &>().transform(
+                    std::declval<const Coefficients &>(),
+                    std::declval<const support::Grid<T> &>(), size_t{0}));
+
+            /*! The common grid of the splines, kept at a fixed address. */
+            internal::StableGrid<T> _grid;
+            /*! The half widths of the intervals of the grid. */
+            const T *_halfWidths = nullptr;
+            /*! The index of the first interval of the support of each spline. */
+            std::vector<size_t> _first;
+            /*!
+     * The transformed coefficients of spline j on the r-th interval of its
+     * support are stored at index _offsets[j] + r. Has size() + 1 elements.
+     */
+            std::vector<size_t> _offsets{0};
+            /*! The coefficients transformed by the first operator. */
+            std::unique_ptr<Left[]> _left;
+            /*! The coefficients transformed by the second operator. */
+            std::unique_ptr<Right[]> _right;
+
+            /*!
+     * Constructs an object for splines defined on a grid. The transformed
+     * coefficients are left uninitialized.
+     *
+     * @param grid The grid.
+     */
+            explicit TransformedSplines(const support::Grid<T> &grid) : _grid(grid) {
+                if (grid.size() > 1) _halfWidths = &_grid.get().halfWidth(0);
+            }
+
+            /*!
+     * Returns the number of intervals of the support of spline j.
+     */
+            size_t numberOfIntervals(size_t j) const { return _offsets[j + 1] - _offsets[j]; };
+
+        public:
+            /*!
+     * Move constructor. The grid is not copied and keeps its address.
+     *
+     * @param other The object to move from.
+     */
+            TransformedSplines(TransformedSplines &&other) noexcept = default;
+
+            /*!
+     * Returns the number of splines.
+     */
+            size_t size() const noexcept { return _first.size(); };
+
+            /*!
+     * Returns the common grid of the splines.
+     */
+            const support::Grid<T> &getGrid() const noexcept { return _grid.get(); };
+        };
+
+        /*!
+   * Applies the operators of the bilinear form to the coefficients of each
+   * spline of a collection on each interval of its support, such that
+   * subsequent evaluations of the bilinear form via
+   * evaluate(const TransformedSplines<T, order> &, size_t, size_t) or
+   * assemble(const TransformedSplines<T, order> &) do not apply the operators
+   * again.
+   *
+   * @param splines The splines. Must provide begin() and end() iterators.
+   * @tparam SplineCollection A collection of splines of type Spline<T, order>
+   * or SplineView<T, order>, e.g. a BSplineBasis<T, order>.
+   * @throws BSplineException If the collection is empty or the splines are
+   * defined on different grids.
+   * @returns The transformed coefficients of the splines.
+   */
+        template<typename SplineCollection>
+        auto transform(const SplineCollection &splines) const {
+            return transform(splines, 1,
+                             [](size_t nTasks, const std::function<void(size_t)> &task) {
+                                 for (size_t c = 0; c < nTasks; c++) task(c);
+                             });
+        }
+
+        /*!
+   * Applies the operators of the bilinear form to the coefficients of a
+   * collection of splines, see transform(const SplineCollection &). The
+   * splines are split into nChunks contiguous chunks, which are transformed by
+   * independent tasks.
+   *
+   * @param splines The splines. Must provide begin() and end() iterators.
+   * @param nChunks The number of chunks the splines are split into.
+   * @param parallelFor Callable executing task(c) for all c in [0, nTasks)
+   * and returning once all tasks are finished, when called as
+   * parallelFor(nTasks, task).
+   * @tparam SplineCollection A collection of splines of type Spline<T, order>
+   * or SplineView<T, order>, e.g. a BSplineBasis<T, order>.
+   * @tparam ParallelFor The type of the callable.
+   * @throws BSplineException If the collection is empty or the splines are
+   * defined on different grids.
+   * @returns The transformed coefficients of the splines.
+   */
+        template<typename SplineCollection, typename ParallelFor>
+        TransformedSplines<typename SplineCollection::value_type::data_type,
+                           SplineCollection::value_type::spline_order>
+        transform(const SplineCollection &splines, size_t nChunks,
+                  const ParallelFor &parallelFor) const {
+            using T = typename SplineCollection::value_type::data_type;
+            static constexpr size_t order = SplineCollection::value_type::spline_order;
+            using Transformed = TransformedSplines<T, order>;
+
+            if (splines.begin() == splines.end()) {
+                throw BSplineException(ErrorCode::MISSING_DATA,
+                                       "The number of splines may not be zero.");
+            }
+            Transformed ret(splines.begin()->getSupport().getGrid());
+
+            std::vector<SplineView<T, order>> views;
+            for (auto it = splines.begin(); it != splines.end(); it++) {
+                const SplineView<T, order> view(*it);
+                const support::Support<T> &support = view.getSupport();
+                if (support.getGrid() != ret.getGrid()) {
+                    throw BSplineException(ErrorCode::DIFFERING_GRIDS);
+                }
+                views.push_back(view);
+                ret._first.push_back(support.getStartIndex());
+                ret._offsets.push_back(ret._offsets.back() + support.numberOfIntervals());
+            }
+            const size_t n = views.size();
+            nChunks = std::max<size_t>(std::min(nChunks, n), 1);
+            const auto chunkBegin = [&](size_t c) { return n * c / nChunks; };
+
+            // The transformed coefficients are left uninitialized until they are
+            // written by the tasks.
+            ret._left.reset(new typename Transformed::Left[ret._offsets.back()]);
+            ret._right.reset(new typename Transformed::Right[ret._offsets.back()]);
+            parallelFor(nChunks, [&](size_t chunk) {
+                for (size_t j = chunkBegin(chunk); j < chunkBegin(chunk + 1); j++) {
+                    for (size_t r = 0; r < ret.numberOfIntervals(j); r++) {
+                        const auto &coefficients = views[j].getCoefficients()[r];
+                        const size_t g = ret._first[j] + r;
+                        ret._left[ret._offsets[j] + r] = _o1.transform(coefficients, ret.getGrid(), g);
+                        ret._right[ret._offsets[j] + r] = _o2.transform(coefficients, ret.getGrid(), g);
+                    }
+                }
+            });
+            return ret;
+        }
+
         /*!
    * Evaluates the bilinear form for two particular splines.
    *
    * @param a The first (left) spline.
    * @param b The second (right) spline.
-   * @tparam T The datatype of the splines.
-   * @tparam ordera The order of the first (left) spline.
-   * @tparam orderb The order of the second (right) spline.
+   * @tparam SplineA The type of the first (left) spline, a Spline or a
+   * SplineView.
+   * @tparam SplineB The type of the second (right) spline, a Spline or a
+   * SplineView.
    * @throws BSplineException If the two splines are defined on different grids.
    * @returns The value of the bilinear form for the two splines.
    */
-        template<typename T, size_t ordera, size_t orderb>
-        T evaluate(const Spline<T, ordera> &a, const Spline<T, orderb> &b) const {
+        template<typename SplineA, typename SplineB,
+                std::enable_if_t<is_spline_or_view_v<SplineA> && is_spline_or_view_v<SplineB>,
+                                 bool> = true>
+        typename SplineA::data_type evaluate(const SplineA &a, const SplineB &b) const {
+            using T = typename SplineA::data_type;
+            static_assert(std::is_same_v<T, typename SplineB::data_type>,
+                          "The splines must be of the same data type.");
+
+            // Views construct their supports on demand, hence the supports are kept.
+            const support::Support<T> &aSupport = a.getSupport();
+            const support::Support<T> &bSupport = b.getSupport();
+
             // Will also check whether the two grids are equivalent.
-            const support::Support integrandSupport =
-                    a.getSupport().calcIntersection(b.getSupport());
+            const support::Support integrandSupport = aSupport.calcIntersection(bSupport);
             const size_t nintervals = integrandSupport.numberOfIntervals();
 
             const auto &grid = integrandSupport.getGrid();
@@ -119,13 +314,10 @@ namespace bspline::integration {
             for (size_t interv = 0; interv < nintervals; interv++) {
                 const auto absIndex = integrandSupport.absoluteFromRelative(interv);
 
-                const auto aIndex =
-                        a.getSupport().intervalIndexFromAbsolute(absIndex).value();
-                const auto bIndex =
-                        b.getSupport().intervalIndexFromAbsolute(absIndex).value();
+                const auto aIndex = aSupport.intervalIndexFromAbsolute(absIndex).value();
+                const auto bIndex = bSupport.intervalIndexFromAbsolute(absIndex).value();
 
-                const T dxhalf = (a.getSupport()[aIndex + 1] - a.getSupport()[aIndex]) /
-                                 static_cast<T>(2);
+                const T &dxhalf = grid.halfWidth(absIndex);
 
                 result += evaluateInterval(
                         _o1.transform(a.getCoefficients()[aIndex], grid, absIndex),
@@ -133,6 +325,401 @@ namespace bspline::integration {
             }
             return result;
         }
+
+        /*!
+   * Evaluates the bilinear form for the splines i and j of a collection
+   * transformed by transform(). The result is identical to the one of
+   * evaluate(const SplineA &, const SplineB &) for the splines themselves.
+   *
+   * @param splines The transformed splines.
+   * @param i The index of the first (left) spline.
+   * @param j The index of the second (right) spline.
+   * @throws BSplineException If i or j is out of bounds.
+   * @returns The value of the bilinear form for the two splines.
+   */
+        template<typename T, size_t order>
+        T evaluate(const TransformedSplines<T, order> &splines, size_t i, size_t j) const {
+            return evaluate(splines, i, splines, j);
+        }
+
+        /*!
+   * Evaluates the bilinear form for spline i of one collection and spline j
+   * of another collection, both transformed by transform(). The result is
+   * identical to the one of evaluate(const SplineA &, const SplineB &) for the
+   * splines themselves.
+   *
+   * @param a The first (left) transformed splines.
+   * @param i The index of the first (left) spline within a.
+   * @param b The second (right) transformed splines.
+   * @param j The index of the second (right) spline within b.
+   * @throws BSplineException If i or j is out of bounds.
+   * @throws BSplineException If the splines are defined on different grids.
+   * @returns The value of the bilinear form for the two splines.
+   */
+        template<typename T, size_t order>
+        T evaluate(const TransformedSplines<T, order> &a, size_t i,
+                   const TransformedSplines<T, order> &b, size_t j) const {
+            if (i >= a.size() || j >= b.size()) {
+                throw BSplineException(ErrorCode::INVALID_ACCESS);
+            } else if (&a != &b && a.getGrid() != b.getGrid()) {
+                throw BSplineException(ErrorCode::DIFFERING_GRIDS);
+            }
+
+            const size_t begin = std::max(a._first[i], b._first[j]);
+            const size_t end = std::min(a._first[i] + a.numberOfIntervals(i),
+                                        b._first[j] + b.numberOfIntervals(j));
+
+            T result = static_cast<T>(0);
+            for (size_t g = begin; g < end; g++) {
+                result += evaluateInterval(a._left[a._offsets[i] + g - a._first[i]],
+                                           b._right[b._offsets[j] + g - b._first[j]],
+                                           a._halfWidths[g]);
+            }
+            return result;
+        }
+
+        /*!
+   * Evaluates the bilinear form for all pairs of splines of a collection, e.g.
+   * the matrix of an operator over a basis of BSplines. Instead of calling
+   * evaluate() for every pair, the operators are applied to the coefficients
+   * of each spline on each interval of its support once, and the contributions
+   * of every interval are accumulated for all splines overlapping on it. For
+   * n BSplines of order k, this requires O(n k^2) interval integrals instead of
+   * O(n^2) calls of evaluate(). The contributions are summed up in the same
+   * order as by evaluate(), hence the values coincide. See
+   * assemble(const SplineCollection &, ParallelEvaluator &) for a
+   * multithreaded variant.
+   *
+   * @param splines The splines \f$b_j\f$. Must provide begin() and end()
+   * iterators.
+   * @tparam SplineCollection A collection of splines of type Spline<T, order>
+   * or SplineView<T, order>, e.g. a BSplineBasis<T, order>.
+   * @throws BSplineException If the collection is empty or the splines are
+   * defined on different grids.
+   * @returns The matrix \f$A_{ij} = \left\langle b_i,\, b_j\right\rangle\f$.
+   * The elements of all pairs of splines whose supports share an interval are
+   * stored.
+   */
+        template<typename SplineCollection>
+        SparseMatrix<typename SplineCollection::value_type::data_type> assemble(
+                const SplineCollection &splines) const {
+            return assemble(splines, 1,
+                            [](size_t nTasks, const std::function<void(size_t)> &task) {
+                                for (size_t c = 0; c < nTasks; c++) task(c);
+                            });
+        }
+
+        /*!
+   * Evaluates the bilinear form for all pairs of splines of a collection, see
+   * assemble(const SplineCollection &). The splines are split into nChunks
+   * contiguous chunks, which are processed by independent tasks: first the
+   * operators are applied to the coefficients of the splines of each chunk,
+   * then the rows of the matrix belonging to the splines of each chunk are
+   * assembled. Every task only writes to its own part of the output and every
+   * element is accumulated in the same order as by evaluate(), hence the
+   * results are identical for any number of chunks and any execution order of
+   * the tasks.
+   *
+   * @param splines The splines \f$b_j\f$. Must provide begin() and end()
+   * iterators.
+   * @param nChunks The number of chunks the splines are split into.
+   * @param parallelFor Callable executing task(c) for all c in [0, nTasks)
+   * and returning once all tasks are finished, when called as
+   * parallelFor(nTasks, task).
+   * @tparam SplineCollection A collection of splines of type Spline<T, order>
+   * or SplineView<T, order>, e.g. a BSplineBasis<T, order>.
+   * @tparam ParallelFor The type of the callable.
+   * @throws BSplineException If the collection is empty or the splines are
+   * defined on different grids.
+   * @returns The matrix \f$A_{ij} = \left\langle b_i,\, b_j\right\rangle\f$.
+   */
+        template<typename SplineCollection, typename ParallelFor>
+        SparseMatrix<typename SplineCollection::value_type::data_type> assemble(
+                const SplineCollection &splines, size_t nChunks,
+                const ParallelFor &parallelFor) const {
+            return assemble(transform(splines, nChunks, parallelFor), nChunks, parallelFor);
+        }
+
+        /*!
+   * Evaluates the bilinear form for all pairs of splines of a collection on
+   * the threads of an evaluator, see
+   * assemble(const SplineCollection &, size_t, const ParallelFor &). The
+   * results are identical to those of assemble(const SplineCollection &),
+   * independent of the number of threads.
+   *
+   * @param splines The splines \f$b_j\f$. Must provide begin() and end()
+   * iterators.
+   * @param evaluator The evaluator providing the threads.
+   * @tparam SplineCollection A collection of splines of type Spline<T, order>
+   * or SplineView<T, order>, e.g. a BSplineBasis<T, order>.
+   * @tparam Evaluator ParallelEvaluator. Deduced, such that this header does not
+   * depend on bspline/ParallelEvaluator.h, which callers include anyway.
+   * @throws BSplineException If the collection is empty or the splines are
+   * defined on different grids.
+   * @returns The matrix \f$A_{ij} = \left\langle b_i,\, b_j\right\rangle\f$.
+   */
+        template<typename SplineCollection, typename Evaluator,
+                 typename = std::enable_if_t<std::is_same_v<Evaluator, ParallelEvaluator>>>
+        SparseMatrix<typename SplineCollection::value_type::data_type> assemble(
+                const SplineCollection &splines, Evaluator &evaluator) const {
+            // Each row costs about as much as the evaluation of (order + 1)^2
+            // points.
+            static constexpr size_t k = SplineCollection::value_type::spline_order + 1;
+            const size_t nSplines = std::distance(splines.begin(), splines.end());
+            return assemble(splines, evaluator.numberOfChunks(nSplines * k * k),
+                            [&evaluator](size_t nTasks, const std::function<void(size_t)> &task) {
+                                evaluator.parallelFor(nTasks, task);
+                            });
+        }
+
+        /*!
+   * Evaluates the bilinear form for all pairs of splines of a uniform basis,
+   * see assemble(const SplineCollection &, size_t, const ParallelFor &). If
+   * both operators are translation invariant (see
+   * operators::is_translation_invariant_v), the value for two translates of the
+   * reference spline only depends on the difference d of their indices,
+   * |d| <= order, if all intervals have the same width. These 2 order + 1
+   * values are computed once from the reference spline and only the elements
+   * involving boundary splines are evaluated explicitly, which requires
+   * O(order^2) interval integrals plus filling in the matrix, independent of
+   * the number of splines. If the widths of the intervals differ, e.g. by
+   * rounding errors, the elements of two translates are accumulated from the
+   * reference coefficients transformed once, each interval being scaled by its
+   * own width. In both cases, the results are identical to those of the
+   * general assembly. For other operators, the general assembly is used.
+   *
+   * @param basis The uniform basis.
+   * @param nChunks The number of chunks the rows are split into.
+   * @param parallelFor Callable executing task(c) for all c in [0, nTasks)
+   * and returning once all tasks are finished, when called as
+   * parallelFor(nTasks, task).
+   * @tparam ParallelFor The type of the callable.
+   * @returns The matrix \f$A_{ij} = \left\langle b_i,\, b_j\right\rangle\f$.
+   */
+        template<typename T, size_t order, typename ParallelFor>
+        SparseMatrix<T> assemble(const UniformBSplineBasis<T, order> &basis, size_t nChunks,
+                                 const ParallelFor &parallelFor) const {
+            if constexpr (!operators::is_translation_invariant_v<O1> ||
+                          !operators::is_translation_invariant_v<O2>) {
+                return assemble(transform(basis, nChunks, parallelFor), nChunks, parallelFor);
+            } else {
+                using Transformed = TransformedSplines<T, order>;
+                const support::Grid<T> &grid = basis.getGrid();
+                const size_t n = basis.size();
+                const size_t translatesBegin = basis.firstTranslate();
+                const size_t translatesEnd = translatesBegin + basis.numberOfTranslates();
+                const auto isTranslate = [&](size_t i) {
+                    return i >= translatesBegin && i < translatesEnd;
+                };
+
+                // The reference spline is supported on the intervals [0, order + 1).
+                const auto &reference = basis.getReferenceCoefficients();
+                std::vector<typename Transformed::Left> left;
+                std::vector<typename Transformed::Right> right;
+                for (size_t r = 0; r < reference.size(); r++) {
+                    left.push_back(_o1.transform(reference[r], grid, r));
+                    right.push_back(_o2.transform(reference[r], grid, r));
+                }
+                const T *halfWidths = &grid.halfWidth(0);
+                const bool equalWidths =
+                        std::all_of(halfWidths, halfWidths + grid.size() - 1,
+                                    [&](const T &halfWidth) { return halfWidth == halfWidths[0]; });
+
+                // If all intervals have the same width, the value for the translates i and
+                // i + d is stored at stencil[order + d].
+                std::array<T, 2 * order + 1> stencil;
+                stencil.fill(static_cast<T>(0));
+                if (equalWidths && !reference.empty()) {
+                    for (size_t s = 0; s <= 2 * order; s++) {
+                        // Interval r of translate i is interval r + order - s of translate
+                        // i + s - order.
+                        for (size_t r = std::max(s, order) - order; r < std::min(order, s) + 1; r++) {
+                            stencil[s] += evaluateInterval(left[r], right[r + order - s], halfWidths[0]);
+                        }
+                    }
+                }
+                const auto evaluateTranslates = [&](size_t i, size_t j) {
+                    if (equalWidths) return stencil[order + j - i];
+                    // Interval r of translate i is interval r + i - j of translate j and
+                    // interval i - translatesBegin + r of the grid.
+                    T value = static_cast<T>(0);
+                    const size_t rEnd = order + 1 - ((i > j) ? i - j : 0);
+                    for (size_t r = (j > i) ? j - i : 0; r < rEnd; r++) {
+                        value += evaluateInterval(left[r], right[r + i - j],
+                                                  halfWidths[i - translatesBegin + r]);
+                    }
+                    return value;
+                };
+
+                // Only splines, whose indices differ by at most order, may overlap.
+                const auto columnsBegin = [&](size_t i) { return (i > order) ? i - order : 0; };
+                const auto columnsEnd = [&](size_t i) { return std::min(n, i + order + 1); };
+                // The supports are compared by their index ranges, translate t being
+                // supported on the grid points [t, t + order + 2).
+                const auto startIndex = [&](size_t i) {
+                    return isTranslate(i) ? i - translatesBegin : basis[i].getStartIndex();
+                };
+                const auto endIndex = [&](size_t i) {
+                    return isTranslate(i) ? i - translatesBegin + order + 2 : basis[i].getEndIndex();
+                };
+                const auto isStored = [&](size_t i, size_t j) {
+                    return (isTranslate(i) && isTranslate(j)) ||
+                           std::min(endIndex(i), endIndex(j)) >= std::max(startIndex(i), startIndex(j)) + 2;
+                };
+
+                SparseMatrix<T> ret;
+                ret.rows = n;
+                ret.cols = n;
+                ret.rowOffsets.assign(n + 1, 0);
+                for (size_t i = 0; i < n; i++) {
+                    size_t count = 0;
+                    for (size_t j = columnsBegin(i); j < columnsEnd(i); j++) {
+                        if (isStored(i, j)) count++;
+                    }
+                    ret.rowOffsets[i + 1] = ret.rowOffsets[i] + count;
+                }
+                ret.columnIndices.resize(ret.rowOffsets.back());
+                ret.values.resize(ret.rowOffsets.back());
+
+                nChunks = std::max<size_t>(std::min(nChunks, n), 1);
+                const auto chunkBegin = [&](size_t c) { return n * c / nChunks; };
+                parallelFor(nChunks, [&](size_t chunk) {
+                    for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+                        size_t k = ret.rowOffsets[i];
+                        for (size_t j = columnsBegin(i); j < columnsEnd(i); j++) {
+                            if (isTranslate(i) && isTranslate(j)) {
+                                ret.values[k] = evaluateTranslates(i, j);
+                            } else if (isStored(i, j)) {
+                                ret.values[k] = evaluate(basis[i], basis[j]);
+                            } else {
+                                continue;
+                            }
+                            ret.columnIndices[k++] = j;
+                        }
+                    }
+                });
+                return ret;
+            }
+        }
+
+        /*!
+   * Evaluates the bilinear form for all pairs of splines of a collection
+   * transformed by transform(), see assemble(const SplineCollection &).
+   *
+   * @param splines The transformed splines.
+   * @returns The matrix \f$A_{ij} = \left\langle b_i,\, b_j\right\rangle\f$.
+   */
+        template<typename T, size_t order>
+        SparseMatrix<T> assemble(const TransformedSplines<T, order> &splines) const {
+            return assemble(splines, 1,
+                            [](size_t nTasks, const std::function<void(size_t)> &task) {
+                                for (size_t c = 0; c < nTasks; c++) task(c);
+                            });
+        }
+
+        /*!
+   * Evaluates the bilinear form for all pairs of splines of a collection
+   * transformed by transform(), the rows being split into nChunks contiguous
+   * chunks processed by independent tasks, see
+   * assemble(const SplineCollection &, size_t, const ParallelFor &).
+   *
+   * @param splines The transformed splines.
+   * @param nChunks The number of chunks the rows are split into.
+   * @param parallelFor Callable executing task(c) for all c in [0, nTasks)
+   * and returning once all tasks are finished, when called as
+   * parallelFor(nTasks, task).
+   * @tparam ParallelFor The type of the callable.
+   * @returns The matrix \f$A_{ij} = \left\langle b_i,\, b_j\right\rangle\f$.
+   */
+        template<typename T, size_t order, typename ParallelFor>
+        SparseMatrix<T> assemble(const TransformedSplines<T, order> &splines, size_t nChunks,
+                                 const ParallelFor &parallelFor) const {
+            const support::Grid<T> &grid = splines.getGrid();
+            const std::vector<size_t> &first = splines._first;
+            const std::vector<size_t> &offsets = splines._offsets;
+            const size_t n = splines.size();
+            nChunks = std::max<size_t>(std::min(nChunks, n), 1);
+            const auto chunkBegin = [&](size_t c) { return n * c / nChunks; };
+
+            // Counting sort of the splines by the intervals of their supports.
+            std::vector<size_t> intervalOffsets(grid.size(), 0);
+            for (size_t j = 0; j < n; j++) {
+                for (size_t g = first[j]; g < first[j] + offsets[j + 1] - offsets[j]; g++) {
+                    intervalOffsets[g + 1]++;
+                }
+            }
+            for (size_t g = 1; g < intervalOffsets.size(); g++) {
+                intervalOffsets[g] += intervalOffsets[g - 1];
+            }
+            std::vector<size_t> intervalSplines(intervalOffsets.back());
+            std::vector<size_t> next(intervalOffsets.begin(), intervalOffsets.end() - 1);
+            for (size_t j = 0; j < n; j++) {
+                for (size_t g = first[j]; g < first[j] + offsets[j + 1] - offsets[j]; g++) {
+                    intervalSplines[next[g]++] = j;
+                }
+            }
+
+            SparseMatrix<T> ret;
+            ret.rows = n;
+            ret.cols = n;
+            ret.rowOffsets.assign(n + 1, 0);
+
+            // The rows of each chunk are first stored separately, then concatenated.
+            std::vector<std::vector<size_t>> chunkColumns(nChunks);
+            std::vector<std::vector<T>> chunkValues(nChunks);
+            parallelFor(nChunks, [&](size_t chunk) {
+                // The position of column j within the current row, n if not present.
+                std::vector<size_t> position(n, n);
+                std::vector<size_t> rowColumns;
+                std::vector<T> rowValues;
+                std::vector<size_t> permutation;
+                for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+                    rowColumns.clear();
+                    rowValues.clear();
+                    for (size_t r = 0; r < offsets[i + 1] - offsets[i]; r++) {
+                        const size_t g = first[i] + r;
+                        for (size_t k = intervalOffsets[g]; k < intervalOffsets[g + 1]; k++) {
+                            const size_t j = intervalSplines[k];
+                            if (position[j] == n) {
+                                position[j] = rowColumns.size();
+                                rowColumns.push_back(j);
+                                rowValues.push_back(static_cast<T>(0));
+                            }
+                            rowValues[position[j]] += evaluateInterval(
+                                    splines._left[offsets[i] + r],
+                                    splines._right[offsets[j] + g - first[j]],
+                                    splines._halfWidths[g]);
+                        }
+                    }
+
+                    permutation.resize(rowColumns.size());
+                    std::iota(permutation.begin(), permutation.end(), 0);
+                    std::sort(permutation.begin(), permutation.end(),
+                              [&](size_t a, size_t b) { return rowColumns[a] < rowColumns[b]; });
+                    for (const size_t m: permutation) {
+                        chunkColumns[chunk].push_back(rowColumns[m]);
+                        chunkValues[chunk].push_back(rowValues[m]);
+                        position[rowColumns[m]] = n;
+                    }
+                    ret.rowOffsets[i + 1] = rowColumns.size();
+                }
+            });
+
+            for (size_t i = 0; i < n; i++) {
+                ret.rowOffsets[i + 1] += ret.rowOffsets[i];
+            }
+            ret.columnIndices.resize(ret.rowOffsets.back());
+            ret.values.resize(ret.rowOffsets.back());
+
+            parallelFor(nChunks, [&](size_t chunk) {
+                const size_t offset = ret.rowOffsets[chunkBegin(chunk)];
+                std::copy(chunkColumns[chunk].begin(), chunkColumns[chunk].end(),
+                          ret.columnIndices.begin() + offset);
+                std::copy(chunkValues[chunk].begin(), chunkValues[chunk].end(),
+                          ret.values.begin() + offset);
+            });
+            return ret;
+        }
     };
 
     /*!
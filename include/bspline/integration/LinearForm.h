@@ -9,8 +9,11 @@
 #define BSPLINE_INTEGRATION_LINEARFORM_H
 
 #include <bspline/Spline.h>
+#include <bspline/SplineView.h>
 #include <bspline/operators/GenericOperators.h>
 
+#include <type_traits>
+
 namespace bspline::integration {
 
     /*!
@@ -69,25 +72,25 @@ namespace bspline::integration {
    * Evaluates the linear form for a particular spline.
    *
    * @param a The  spline.
-   * @tparam T The datatype of the splines.
-   * @tparam order The order of the spline.
+   * @tparam S The type of the spline, a Spline or a SplineView.
    * @returns The value of the linear form for the given spline.
    */
-        template<typename T, size_t order>
-        T evaluate(const Spline<T, order> &a) const {
-            const size_t nintervals = a.getSupport().numberOfIntervals();
+        template<typename S, std::enable_if_t<is_spline_or_view_v<S>, bool> = true>
+        typename S::data_type evaluate(const S &a) const {
+            using T = typename S::data_type;
+            // Views construct their support on demand, hence it is kept.
+            const support::Support<T> &aSupport = a.getSupport();
+            const size_t nintervals = aSupport.numberOfIntervals();
 
             T result = static_cast<T>(0);
 
             for (size_t i = 0; i < nintervals; i++) {
-                const size_t absIndex = a.getSupport().absoluteFromRelative(i);
-                const T dxhalf =
-                        (a.getSupport()[i + 1] - a.getSupport()[i]) / static_cast<T>(2);
-
-                result +=
-                        evaluateInterval(_o.transform(a.getCoefficients()[i],
-                                                      a.getSupport().getGrid(), absIndex),
-                                         dxhalf);
+                const size_t absIndex = aSupport.absoluteFromRelative(i);
+                const T &dxhalf = aSupport.intervalHalfWidth(i);
+
+                result += evaluateInterval(
+                        _o.transform(a.getCoefficients()[i], aSupport.getGrid(), absIndex),
+                        dxhalf);
             }
             return result;
         }
@@ -54,7 +54,7 @@ namespace bspline::integration {
 
             const T &xstart = m1.getSupport().at(m1Index);
             const T &xend = m1.getSupport().at(m1Index + 1);
-            const T xm = (xstart + xend) / static_cast<T>(2);
+            const T &xm = m1.getSupport().intervalMidpoint(m1Index);
             const auto &c1 = m1.getCoefficients().at(m1Index);
             const auto &c2 = m2.getCoefficients().at(m2Index);
             result += gauss<T, ordergl>::integrate(
@@ -0,0 +1,254 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_INTERNAL_GRIDCACHE_H
+#define BSPLINE_INTERNAL_GRIDCACHE_H
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#ifndef BSPLINE_DOXYGEN_IGNORE
+namespace bspline::internal {
+
+    /*!
+ * Holds data derived from the points of a grid, which speeds up queries on the
+ * grid. The data is built lazily on first use and shared between all copies of
+ * a grid. All methods are thread safe.
+ *
+ * @tparam T The datatype of the grid elements.
+ */
+    template<typename T>
+    class GridCache final {
+    public:
+        /*!
+   * Minimal number of grid points of a non-uniform grid, for which the grid
+   * points are rearranged in the Eytzinger layout. For smaller grids, the
+   * binary search on the grid points already runs within the cache.
+   */
+        static constexpr size_t EYTZINGER_THRESHOLD = 512;
+
+    private:
+        /*!
+   * Parameters of a grid, whose points are (approximately) equally spaced.
+   */
+        struct UniformSpacing {
+            /*! The first grid point. */
+            T front;
+            /*! The inverse of the average spacing of the grid points. */
+            T inverseStep;
+        };
+
+        /*! Guards the initialization of the lookup data. */
+        std::once_flag _lookupFlag;
+
+        /*! Is set if the grid points are equally spaced. */
+        std::optional<UniformSpacing> _uniformSpacing;
+
+        /*!
+   * The grid points in the Eytzinger (breadth-first binary tree) layout. The
+   * element at index 0 is unused, the children of the element at index k are
+   * located at the indices 2k and 2k+1. The top levels of the tree share a few
+   * cache lines, which makes the binary search considerably more cache friendly
+   * than on the sorted grid points.
+   */
+        std::vector<T> _eytzinger;
+
+        /*! The index of the grid point for each element of _eytzinger. */
+        std::vector<size_t> _eytzingerIndex;
+
+        /*! Guards the initialization of the interval data. */
+        std::once_flag _intervalFlag;
+
+        /*! The midpoints of the intervals. */
+        std::vector<T> _midpoints;
+
+        /*! The half widths of the intervals. */
+        std::vector<T> _halfWidths;
+
+        /*!
+   * Fills the subtree with root k of the Eytzinger layout by an in-order
+   * traversal.
+   *
+   * @param points The grid points.
+   * @param k The index of the root of the subtree.
+   * @param i The index of the next grid point to insert.
+   * @returns The index of the next grid point to insert after the subtree has
+   * been filled.
+   */
+        size_t fillEytzinger(const std::vector<T> &points, size_t k, size_t i) {
+            if (k <= points.size()) {
+                i = fillEytzinger(points, 2 * k, i);
+                _eytzinger[k] = points[i];
+                _eytzingerIndex[k] = i;
+                i = fillEytzinger(points, 2 * k + 1, i + 1);
+            }
+            return i;
+        }
+
+        /*!
+   * Performs the equivalent of std::lower_bound on the Eytzinger layout.
+   *
+   * @param x The point to search for.
+   * @returns The index of the first grid point which is not smaller than x or
+   * the number of grid points if there is no such point.
+   */
+        size_t eytzingerLowerBound(const T &x) const {
+            const size_t n = _eytzinger.size() - 1;
+            size_t k = 1;
+            while (k <= n) {
+#if defined(__GNUC__)
+                // The descendants four levels down share one cache line.
+                __builtin_prefetch(_eytzinger.data() + std::min(16 * k, n));
+#endif
+                k = 2 * k + static_cast<size_t>(_eytzinger[k] < x);
+            }
+            // Undo the right turns taken after the last left turn.
+            while (k & 1) {
+                k >>= 1;
+            }
+            k >>= 1;
+            return (k == 0) ? n : _eytzingerIndex[k];
+        }
+
+        /*!
+   * Checks whether the grid points are equally spaced and sets _uniformSpacing
+   * accordingly. The grid is considered to be uniform, if every grid point
+   * deviates by at most a quarter of the average spacing from its ideal
+   * position. In this case, the index arithmetic yields the correct interval
+   * up to a correction of at most one index. Large non-uniform grids are
+   * rearranged in the Eytzinger layout instead.
+   *
+   * @param points The grid points.
+   */
+        void initLookup(const std::vector<T> &points) {
+            const size_t n = points.size();
+            const T step = (points.back() - points.front()) / static_cast<T>(n - 1);
+            const T tolerance = step / static_cast<T>(4);
+
+            bool isUniform = true;
+            for (size_t i = 1; i + 1 < n && isUniform; i++) {
+                const T deviation =
+                        points[i] - (points.front() + static_cast<T>(i) * step);
+                isUniform = !(deviation > tolerance || -deviation > tolerance);
+            }
+
+            if (isUniform) {
+                _uniformSpacing = UniformSpacing{points.front(), static_cast<T>(1) / step};
+            } else if (n >= EYTZINGER_THRESHOLD) {
+                _eytzinger.resize(n + 1);
+                _eytzingerIndex.resize(n + 1);
+                fillEytzinger(points, 1, 0);
+            }
+        }
+
+        /*!
+   * Makes sure the lookup data is initialized.
+   *
+   * @param points The grid points.
+   */
+        void ensureLookup(const std::vector<T> &points) {
+            std::call_once(_lookupFlag, [this, &points]() { initLookup(points); });
+        }
+
+        /*!
+   * Makes sure the midpoints and half widths of the intervals are computed.
+   *
+   * @param points The grid points.
+   */
+        void ensureIntervals(const std::vector<T> &points) {
+            std::call_once(_intervalFlag, [this, &points]() {
+                const size_t nIntervals = points.size() - 1;
+                _midpoints.reserve(nIntervals);
+                _halfWidths.reserve(nIntervals);
+                for (size_t i = 0; i < nIntervals; i++) {
+                    _midpoints.push_back((points[i + 1] + points[i]) / static_cast<T>(2));
+                    _halfWidths.push_back((points[i + 1] - points[i]) / static_cast<T>(2));
+                }
+            });
+        }
+
+    public:
+        /*!
+   * Returns the midpoints of the intervals, the i-th element belonging to the
+   * interval beginning at grid point i.
+   *
+   * @param points The grid points.
+   * @returns The midpoints of the intervals.
+   */
+        const std::vector<T> &getMidpoints(const std::vector<T> &points) {
+            ensureIntervals(points);
+            return _midpoints;
+        }
+
+        /*!
+   * Returns the half widths of the intervals, the i-th element belonging to the
+   * interval beginning at grid point i.
+   *
+   * @param points The grid points.
+   * @returns The half widths of the intervals.
+   */
+        const std::vector<T> &getHalfWidths(const std::vector<T> &points) {
+            ensureIntervals(points);
+            return _halfWidths;
+        }
+
+        /*!
+   * Checks whether the grid points are equally spaced.
+   *
+   * @param points The grid points.
+   * @returns True if the grid points are (approximately) equally spaced.
+   */
+        bool isUniform(const std::vector<T> &points) {
+            ensureLookup(points);
+            return _uniformSpacing.has_value();
+        }
+
+        /*!
+   * Finds the interval containing x. An interval contains its right boundary,
+   * the first interval also its left boundary. The result thus coincides with
+   * the one of a binary search via std::lower_bound.
+   *
+   * @param points The grid points.
+   * @param x The point to search for. Must fulfil points.front() <= x <=
+   * points.back().
+   * @returns The index of the grid point at the beginning of the interval.
+   */
+        size_t findInterval(const std::vector<T> &points, const T &x) {
+            ensureLookup(points);
+            const size_t lastInterval = points.size() - 2;
+
+            if (!_uniformSpacing) {
+                size_t intervalEndIndex;
+                if (!_eytzinger.empty()) {
+                    intervalEndIndex = eytzingerLowerBound(x);
+                } else {
+                    const auto it = std::lower_bound(points.begin(), points.end(), x);
+                    intervalEndIndex = std::distance(points.begin(), it);
+                }
+                return std::max<size_t>(intervalEndIndex, 1) - 1;
+            }
+
+            // Direct index arithmetic, corrected by comparison with the neighboring
+            // grid points.
+            const T position = (x - _uniformSpacing->front) * _uniformSpacing->inverseStep;
+            size_t index = std::min(static_cast<size_t>(position), lastInterval);
+
+            while (index > 0 && !(points[index] < x)) {
+                index--;
+            }
+            while (index < lastInterval && points[index + 1] < x) {
+                index++;
+            }
+            return index;
+        }
+    };
+
+}// namespace bspline::internal
+#endif// BSPLINE_DOXYGEN_IGNORE
+#endif// BSPLINE_INTERNAL_GRIDCACHE_H
@@ -0,0 +1,104 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_INTERNAL_INDEXITERATOR_H
+#define BSPLINE_INTERNAL_INDEXITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+
+#ifndef BSPLINE_DOXYGEN_IGNORE
+namespace bspline::internal {
+
+    /*!
+ * Random access iterator referencing the elements of a collection, which
+ * returns its elements by value from operator[](), e.g. the SplineView objects
+ * of a BSplineBasis.
+ *
+ * @tparam Collection The type of the collection.
+ */
+    template<typename Collection>
+    class IndexIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename Collection::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+
+        /*!
+   * Holds the element returned by operator->().
+   */
+        struct pointer {
+            value_type element;
+            const value_type *operator->() const { return &element; }
+        };
+
+    private:
+        /*! The collection. */
+        const Collection *_collection = nullptr;
+        /*! The index of the referenced element. */
+        difference_type _index = 0;
+
+    public:
+        IndexIterator() = default;
+
+        /*!
+   * Constructs an iterator referencing an element of a collection.
+   *
+   * @param collection The collection.
+   * @param index The index of the element.
+   */
+        IndexIterator(const Collection *collection, difference_type index)
+                : _collection(collection), _index(index) {}
+
+        reference operator*() const { return (*_collection)[_index]; }
+        pointer operator->() const { return pointer{**this}; }
+        reference operator[](difference_type n) const { return (*_collection)[_index + n]; }
+
+        IndexIterator &operator++() {
+            _index++;
+            return *this;
+        }
+        IndexIterator operator++(int) { return IndexIterator(_collection, _index++); }
+        IndexIterator &operator--() {
+            _index--;
+            return *this;
+        }
+        IndexIterator operator--(int) { return IndexIterator(_collection, _index--); }
+        IndexIterator &operator+=(difference_type n) {
+            _index += n;
+            return *this;
+        }
+        IndexIterator &operator-=(difference_type n) {
+            _index -= n;
+            return *this;
+        }
+        IndexIterator operator+(difference_type n) const {
+            return IndexIterator(_collection, _index + n);
+        }
+        friend IndexIterator operator+(difference_type n, const IndexIterator &it) {
+            return it + n;
+        }
+        IndexIterator operator-(difference_type n) const {
+            return IndexIterator(_collection, _index - n);
+        }
+        difference_type operator-(const IndexIterator &other) const {
+            return _index - other._index;
+        }
+
+        bool operator==(const IndexIterator &other) const { return _index == other._index; }
+        bool operator!=(const IndexIterator &other) const { return _index != other._index; }
+        bool operator<(const IndexIterator &other) const { return _index < other._index; }
+        bool operator>(const IndexIterator &other) const { return _index > other._index; }
+        bool operator<=(const IndexIterator &other) const { return _index <= other._index; }
+        bool operator>=(const IndexIterator &other) const { return _index >= other._index; }
+    };
+
+}// namespace bspline::internal
+
+#endif// BSPLINE_DOXYGEN_IGNORE
+#endif// BSPLINE_INTERNAL_INDEXITERATOR_H
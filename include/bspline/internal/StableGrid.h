@@ -0,0 +1,60 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_INTERNAL_STABLEGRID_H
+#define BSPLINE_INTERNAL_STABLEGRID_H
+
+#include <bspline/support/Grid.h>
+
+#include <memory>
+
+#ifndef BSPLINE_DOXYGEN_IGNORE
+namespace bspline::internal {
+
+    /*!
+ * Holds a grid at a fixed address, for classes that hand out views referring
+ * to their grid. Grid itself cannot be moved, such that a class storing it by
+ * value would copy it on every move. Moving a StableGrid transfers the
+ * ownership instead, hence views obtained before the move stay valid. Copies
+ * hold a new grid object, which shares the points with the original one.
+ *
+ * @tparam T The datatype of the grid elements.
+ */
+    template<typename T>
+    class StableGrid final {
+    private:
+        /*! The grid. Null only after the object was moved from. */
+        std::unique_ptr<const support::Grid<T>> _grid;
+
+    public:
+        /*!
+   * Holds a copy of a grid.
+   *
+   * @param grid The grid.
+   */
+        explicit StableGrid(const support::Grid<T> &grid)
+            : _grid(std::make_unique<const support::Grid<T>>(grid)) {}
+
+        StableGrid(const StableGrid &other) : StableGrid(*other._grid) {}
+
+        StableGrid(StableGrid &&other) noexcept = default;
+
+        StableGrid &operator=(const StableGrid &other) {
+            _grid = std::make_unique<const support::Grid<T>>(*other._grid);
+            return *this;
+        }
+
+        StableGrid &operator=(StableGrid &&other) noexcept = default;
+
+        /*!
+   * Returns the grid.
+   */
+        const support::Grid<T> &get() const noexcept { return *_grid; }
+    };
+}// namespace bspline::internal
+#endif// BSPLINE_DOXYGEN_IGNORE
+#endif// BSPLINE_INTERNAL_STABLEGRID_H
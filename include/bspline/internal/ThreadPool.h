@@ -0,0 +1,225 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_INTERNAL_THREADPOOL_H
+#define BSPLINE_INTERNAL_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef BSPLINE_DOXYGEN_IGNORE
+namespace bspline::internal {
+
+    /*!
+ * A fixed set of worker threads executing indexed tasks. The thread calling
+ * parallelFor() takes part in the work, such that a pool of size n uses n - 1
+ * worker threads. Concurrent calls of parallelFor() are serialized. A task may
+ * call parallelFor() of the pool executing it, in which case the nested tasks
+ * are executed inline by the calling thread.
+ */
+    class ThreadPool final {
+    private:
+        /*! The worker threads. */
+        std::vector<std::thread> _workers;
+
+        /*! Serializes calls of parallelFor(). */
+        std::mutex _submitMutex;
+        /*! Guards the state shared with the workers. */
+        std::mutex _mutex;
+        /*! Signals the workers a new job or the shutdown. */
+        std::condition_variable _wakeUp;
+        /*! Signals the submitting thread that all workers left the job. */
+        std::condition_variable _finished;
+
+        /*! Is incremented for each job. */
+        size_t _generation = 0;
+        /*! Number of workers, which did not yet leave the current job. */
+        size_t _activeWorkers = 0;
+        /*! Is set if the workers shall terminate. */
+        bool _stop = false;
+
+        /*! The task of the current job. */
+        const std::function<void(size_t)> *_task = nullptr;
+        /*! The number of tasks of the current job. */
+        size_t _nTasks = 0;
+        /*! The index of the next unclaimed task. */
+        std::atomic<size_t> _nextTask{0};
+        /*! The first exception thrown by a task of the current job. */
+        std::exception_ptr _error;
+        /*! Guards _error. */
+        std::mutex _errorMutex;
+
+        /*!
+   * Marks a pool, whose tasks are being executed by the current thread. The
+   * frames of a thread form a stack linked by prev.
+   */
+        struct Frame {
+            /*! The pool. */
+            const ThreadPool *pool;
+            /*! The frame of the enclosing job or nullptr. */
+            const Frame *prev;
+        };
+
+        /*!
+   * Returns the innermost frame of the current thread.
+   *
+   * @returns A reference to the thread local pointer to the innermost frame.
+   */
+        static const Frame *&currentFrame() {
+            thread_local const Frame *frame = nullptr;
+            return frame;
+        }
+
+        /*!
+   * Checks whether the current thread is executing a task of this pool.
+   *
+   * @returns True if parallelFor() is called from within a task of this pool.
+   */
+        bool isReentrant() const {
+            for (const Frame *frame = currentFrame(); frame; frame = frame->prev) {
+                if (frame->pool == this) return true;
+            }
+            return false;
+        }
+
+        /*!
+   * Executes task(i) for all i in [0, nTasks) on the calling thread. If tasks
+   * throw, the remaining tasks are still executed and the first exception is
+   * rethrown afterwards.
+   *
+   * @param nTasks The number of tasks.
+   * @param task The task, called with the index of the task.
+   */
+        static void runInline(size_t nTasks, const std::function<void(size_t)> &task) {
+            std::exception_ptr error;
+            for (size_t i = 0; i < nTasks; i++) {
+                try {
+                    task(i);
+                } catch (...) {
+                    if (!error) error = std::current_exception();
+                }
+            }
+            if (error) std::rethrow_exception(error);
+        }
+
+        /*!
+   * Claims and executes tasks of the current job until none is left.
+   */
+        void runTasks() {
+            const Frame frame{this, currentFrame()};
+            currentFrame() = &frame;
+            for (size_t i = _nextTask++; i < _nTasks; i = _nextTask++) {
+                try {
+                    (*_task)(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(_errorMutex);
+                    if (!_error) _error = std::current_exception();
+                }
+            }
+            currentFrame() = frame.prev;
+        }
+
+        /*!
+   * The loop of a worker thread.
+   */
+        void work() {
+            size_t seenGeneration = 0;
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true) {
+                _wakeUp.wait(lock, [&] { return _stop || _generation != seenGeneration; });
+                if (_stop) return;
+                seenGeneration = _generation;
+
+                lock.unlock();
+                runTasks();
+                lock.lock();
+
+                if (--_activeWorkers == 0) _finished.notify_one();
+            }
+        }
+
+    public:
+        /*!
+   * Constructs a pool.
+   *
+   * @param size The number of threads executing the tasks, including the
+   * calling thread. A size of zero is treated as one.
+   */
+        explicit ThreadPool(size_t size) {
+            for (size_t i = 1; i < size; i++) {
+                _workers.emplace_back([this] { work(); });
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _wakeUp.notify_all();
+            for (auto &worker: _workers) {
+                worker.join();
+            }
+        }
+
+        /*!
+   * Returns the number of threads executing the tasks, including the calling
+   * thread.
+   *
+   * @returns The size of the pool.
+   */
+        size_t size() const { return _workers.size() + 1; };
+
+        /*!
+   * Executes task(i) for all i in [0, nTasks) and blocks until all tasks are
+   * finished. If tasks throw, the remaining tasks are still executed and the
+   * first exception is rethrown afterwards. If called from within a task of
+   * this pool, the tasks are executed inline by the calling thread, as the
+   * workers are busy with the enclosing job.
+   *
+   * @param nTasks The number of tasks.
+   * @param task The task, called with the index of the task.
+   */
+        void parallelFor(size_t nTasks, const std::function<void(size_t)> &task) {
+            if (isReentrant()) {
+                runInline(nTasks, task);
+                return;
+            }
+            std::lock_guard<std::mutex> submitLock(_submitMutex);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _task = &task;
+                _nTasks = nTasks;
+                _nextTask = 0;
+                _error = nullptr;
+                _activeWorkers = _workers.size();
+                _generation++;
+            }
+            _wakeUp.notify_all();
+
+            runTasks();
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _finished.wait(lock, [&] { return _activeWorkers == 0; });
+            _task = nullptr;
+            if (_error) std::rethrow_exception(_error);
+        }
+    };
+
+}// namespace bspline::internal
+#endif// BSPLINE_DOXYGEN_IGNORE
+#endif// BSPLINE_INTERNAL_THREADPOOL_H
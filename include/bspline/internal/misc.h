@@ -9,6 +9,7 @@
 #define BSPLINE_MISC_H
 
 #include <array>
+#include <cstddef>
 
 #ifndef BSPLINE_DOXYGEN_IGNORE
 /*!
@@ -106,6 +107,45 @@ namespace bspline::internal {
         return result;
     }
 
+    /*!
+ * Evaluates the polynomial defined by coeffs and its first m derivatives at
+ * point x, using the extended Horner scheme. The value coincides exactly with
+ * the one returned by evaluateInterval().
+ *
+ * @param x The point at which to evaluate the polynomial.
+ * @param coeffs The coefficients of the polynomial.
+ * @param xm The middlepoint of the interval with respect to which the
+ * polynomial coefficients are defined.
+ * @tparam m The number of derivatives to evaluate.
+ * @tparam T The datatype of the polynomial.
+ * @tparam size The size of the coefficient array (i.e. the order of the
+ * polynomial plus one).
+ * @returns The array holding the value of the polynomial and its first m
+ * derivatives.
+ */
+    template<size_t m, typename T, size_t size>
+    std::array<T, m + 1> evaluateIntervalDerivatives(
+            const T &x, const std::array<T, size> &coeffs, const T &xm) {
+        const T dx = x - xm;
+        std::array<T, m + 1> result;
+        result.fill(static_cast<T>(0));
+        result[0] = coeffs.back();
+        for (auto it = coeffs.rbegin() + 1; it != coeffs.rend(); it++) {
+            for (size_t j = m; j > 0; j--) {
+                result[j] = dx * result[j] + result[j - 1];
+            }
+            result[0] = dx * result[0] + (*it);
+        }
+
+        // result[j] holds the j-th Taylor coefficient.
+        T fac = static_cast<T>(1);
+        for (size_t j = 2; j <= m; j++) {
+            fac *= static_cast<T>(j);
+            result[j] *= fac;
+        }
+        return result;
+    }
+
     /*!
  * Returns the faculty \f$n!\f$.
  *
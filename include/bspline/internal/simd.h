@@ -0,0 +1,352 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+/**
+ * This file contains the vectorized evaluation kernels. The vector registers
+ * are used if the corresponding instruction set is enabled at compile time
+ * (e.g. via -mavx2 or -mavx512f). Otherwise, a portable implementation is used.
+ */
+#ifndef BSPLINE_INTERNAL_SIMD_H
+#define BSPLINE_INTERNAL_SIMD_H
+
+#include <bspline/internal/misc.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+#ifndef BSPLINE_DOXYGEN_IGNORE
+namespace bspline::internal {
+
+    /*!
+ * Number of points which are collected before the vectorized kernel is
+ * invoked.
+ */
+    inline constexpr size_t SIMD_BATCH_SIZE = 64;
+
+    /*!
+ * Indicates whether the vectorized kernels are available for the data type T.
+ *
+ * @tparam T The data type.
+ */
+    template<typename T>
+    inline constexpr bool has_simd_kernel_v =
+            std::is_same_v<T, double> || std::is_same_v<T, float>;
+
+    /*!
+ * Alignment of the coefficient arrays of structure-of-arrays kernels. Matches
+ * the size of a cache line and of an AVX-512 register.
+ */
+    inline constexpr size_t SIMD_ALIGNMENT = 64;
+
+    /*!
+ * Allocator returning memory aligned to at least SIMD_ALIGNMENT bytes.
+ *
+ * @tparam T The type of the allocated elements.
+ */
+    template<typename T>
+    struct AlignedAllocator {
+        using value_type = T;
+
+        /*! Alignment of the allocated memory. */
+        static constexpr size_t ALIGNMENT = std::max(SIMD_ALIGNMENT, alignof(T));
+
+        AlignedAllocator() = default;
+
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U> &) noexcept {}
+
+        T *allocate(size_t n) {
+            return static_cast<T *>(
+                    ::operator new(n * sizeof(T), std::align_val_t(ALIGNMENT)));
+        }
+
+        void deallocate(T *p, size_t) noexcept {
+            ::operator delete(p, std::align_val_t(ALIGNMENT));
+        }
+
+        template<typename U>
+        bool operator==(const AlignedAllocator<U> &) const noexcept {
+            return true;
+        }
+
+        template<typename U>
+        bool operator!=(const AlignedAllocator<U> &) const noexcept {
+            return false;
+        }
+    };
+
+    /*!
+ * Describes the vector registers used for the data type T. The primary template
+ * indicates that no vector registers are available.
+ *
+ * @tparam T The data type.
+ */
+    template<typename T>
+    struct SimdRegister {
+        /*! Number of values per register. Zero, if not available. */
+        static constexpr size_t WIDTH = 0;
+    };
+
+#if defined(__AVX512F__) || defined(__AVX__)
+    static_assert(sizeof(size_t) == 8, "The gathers expect 64 bit indices.");
+#endif
+
+#if defined(__AVX512F__)
+    /*! AVX-512 registers holding eight doubles. */
+    template<>
+    struct SimdRegister<double> {
+        using type = __m512d;
+        static constexpr size_t WIDTH = 8;
+        static type load(const double *p) { return _mm512_loadu_pd(p); }
+        static void store(double *p, type v) { _mm512_storeu_pd(p, v); }
+        static type broadcast(double v) { return _mm512_set1_pd(v); }
+        static type sub(type a, type b) { return _mm512_sub_pd(a, b); }
+        static type mul(type a, type b) { return _mm512_mul_pd(a, b); }
+        static type add(type a, type b) { return _mm512_add_pd(a, b); }
+        static type gather(const double *p, const size_t *indices) {
+            // Masked gather, as the unmasked one of GCC 12 reads an uninitialized
+            // source register.
+            return _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF,
+                                            _mm512_loadu_si512(indices), p, sizeof(double));
+        }
+    };
+
+    /*! AVX-512 registers holding sixteen floats. */
+    template<>
+    struct SimdRegister<float> {
+        using type = __m512;
+        static constexpr size_t WIDTH = 16;
+        static type load(const float *p) { return _mm512_loadu_ps(p); }
+        static void store(float *p, type v) { _mm512_storeu_ps(p, v); }
+        static type broadcast(float v) { return _mm512_set1_ps(v); }
+        static type sub(type a, type b) { return _mm512_sub_ps(a, b); }
+        static type mul(type a, type b) { return _mm512_mul_ps(a, b); }
+        static type add(type a, type b) { return _mm512_add_ps(a, b); }
+        static type gather(const float *p, const size_t *indices) {
+            const auto gatherHalf = [p](const size_t *i) {
+                return _mm512_mask_i64gather_ps(_mm256_setzero_ps(), 0xFF,
+                                                _mm512_loadu_si512(i), p, sizeof(float));
+            };
+            const __m256 low = gatherHalf(indices);
+            const __m256 high = gatherHalf(indices + 8);
+            // Masked inserts, as the unmasked ones of GCC 12 read an uninitialized
+            // source register.
+            const __m512d zero = _mm512_setzero_pd();
+            const __m512d lowHalf =
+                    _mm512_mask_insertf64x4(zero, 0xFF, zero, _mm256_castps_pd(low), 0);
+            return _mm512_castpd_ps(
+                    _mm512_mask_insertf64x4(zero, 0xFF, lowHalf, _mm256_castps_pd(high), 1));
+        }
+    };
+#elif defined(__AVX__)
+    /*! AVX registers holding four doubles. */
+    template<>
+    struct SimdRegister<double> {
+        using type = __m256d;
+        static constexpr size_t WIDTH = 4;
+        static type load(const double *p) { return _mm256_loadu_pd(p); }
+        static void store(double *p, type v) { _mm256_storeu_pd(p, v); }
+        static type broadcast(double v) { return _mm256_set1_pd(v); }
+        static type sub(type a, type b) { return _mm256_sub_pd(a, b); }
+        static type mul(type a, type b) { return _mm256_mul_pd(a, b); }
+        static type add(type a, type b) { return _mm256_add_pd(a, b); }
+        static type gather(const double *p, const size_t *indices) {
+#if defined(__AVX2__)
+            return _mm256_i64gather_pd(
+                    p, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices)),
+                    sizeof(double));
+#else
+            return _mm256_set_pd(p[indices[3]], p[indices[2]], p[indices[1]],
+                                 p[indices[0]]);
+#endif
+        }
+    };
+
+    /*! AVX registers holding eight floats. */
+    template<>
+    struct SimdRegister<float> {
+        using type = __m256;
+        static constexpr size_t WIDTH = 8;
+        static type load(const float *p) { return _mm256_loadu_ps(p); }
+        static void store(float *p, type v) { _mm256_storeu_ps(p, v); }
+        static type broadcast(float v) { return _mm256_set1_ps(v); }
+        static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+        static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+        static type add(type a, type b) { return _mm256_add_ps(a, b); }
+        static type gather(const float *p, const size_t *indices) {
+#if defined(__AVX2__)
+            const auto load = [](const size_t *i) {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(i));
+            };
+            return _mm256_set_m128(_mm256_i64gather_ps(p, load(indices + 4), sizeof(float)),
+                                   _mm256_i64gather_ps(p, load(indices), sizeof(float)));
+#else
+            return _mm256_set_ps(p[indices[7]], p[indices[6]], p[indices[5]],
+                                 p[indices[4]], p[indices[3]], p[indices[2]],
+                                 p[indices[1]], p[indices[0]]);
+#endif
+        }
+    };
+#endif
+
+    /*!
+ * Evaluates the polynomial defined by coeffs at the n points x using Horner's
+ * scheme. All points are expected to lie in the same interval. Multiplication
+ * and addition are kept separate, such that the results coincide with those of
+ * evaluateInterval() unless the compiler contracts the latter into fused
+ * multiply-adds.
+ *
+ * @param x Pointer to the first of the n points.
+ * @param n The number of points.
+ * @param coeffs The coefficients of the polynomial.
+ * @param xm The middlepoint of the interval with respect to which the
+ * polynomial coefficients are defined.
+ * @param out Pointer to the first of the n output values.
+ * @tparam T The datatype of the polynomial.
+ * @tparam size The size of the coefficient array (i.e. the order of the
+ * polynomial plus one).
+ */
+    template<typename T, size_t size>
+    void evaluateIntervalBatch(const T *x, size_t n,
+                               const std::array<T, size> &coeffs, const T &xm,
+                               T *out) {
+        size_t i = 0;
+
+        if constexpr (SimdRegister<T>::WIDTH > 0) {
+            using R = SimdRegister<T>;
+            const auto vxm = R::broadcast(xm);
+            for (; i + R::WIDTH <= n; i += R::WIDTH) {
+                const auto dx = R::sub(R::load(x + i), vxm);
+                auto result = R::broadcast(coeffs.back());
+                for (auto it = coeffs.rbegin() + 1; it != coeffs.rend(); it++) {
+                    result = R::add(R::mul(dx, result), R::broadcast(*it));
+                }
+                R::store(out + i, result);
+            }
+        } else if constexpr (has_simd_kernel_v<T>) {
+            // Portable fallback: Blocks of fixed size with independent lanes, which
+            // the compiler is able to vectorize.
+            constexpr size_t WIDTH = 8;
+            for (; i + WIDTH <= n; i += WIDTH) {
+                std::array<T, WIDTH> dx;
+                std::array<T, WIDTH> result;
+                for (size_t l = 0; l < WIDTH; l++) {
+                    dx[l] = x[i + l] - xm;
+                    result[l] = coeffs.back();
+                }
+                for (auto it = coeffs.rbegin() + 1; it != coeffs.rend(); it++) {
+                    for (size_t l = 0; l < WIDTH; l++) {
+                        result[l] = dx[l] * result[l] + (*it);
+                    }
+                }
+                for (size_t l = 0; l < WIDTH; l++) {
+                    out[i + l] = result[l];
+                }
+            }
+        }
+
+        // Remainder (or all points for types without vectorized kernel).
+        for (; i < n; i++) {
+            out[i] = evaluateInterval(x[i], coeffs, xm);
+        }
+    }
+
+    /*!
+ * Evaluates a piecewise polynomial stored in structure-of-arrays layout at the
+ * n points x, which may lie in arbitrary intervals. The coefficient of power p
+ * on interval i is located at coefficients[p * stride + i]. The points are
+ * processed in blocks of the register width. The coefficients are gathered
+ * from their intervals, or broadcast if all points of a block share the same
+ * interval. The arithmetic coincides with the one of evaluateInterval().
+ *
+ * @param x Pointer to the first of the n points.
+ * @param intervals Pointer to the interval indices of the n points.
+ * @param n The number of points.
+ * @param coefficients The coefficients, power-major.
+ * @param stride The distance between the coefficients of consecutive powers.
+ * @param midpoints The middlepoints of the intervals.
+ * @param out Pointer to the first of the n output values.
+ * @tparam size The number of coefficients per interval (i.e. the order of the
+ * polynomials plus one).
+ * @tparam T The datatype of the polynomials.
+ */
+    template<size_t size, typename T>
+    void evaluateIntervalsGather(const T *x, const size_t *intervals, size_t n,
+                                 const T *coefficients, size_t stride,
+                                 const T *midpoints, T *out) {
+        size_t i = 0;
+
+        if constexpr (SimdRegister<T>::WIDTH > 0) {
+            using R = SimdRegister<T>;
+            for (; i + R::WIDTH <= n; i += R::WIDTH) {
+                const size_t *indices = intervals + i;
+                const bool sameInterval =
+                        std::all_of(indices + 1, indices + R::WIDTH,
+                                    [&](size_t index) { return index == indices[0]; });
+
+                auto result = R::broadcast(static_cast<T>(0));
+                if (sameInterval) {
+                    // Typical for sorted points: Broadcast instead of gather.
+                    const auto dx = R::sub(R::load(x + i), R::broadcast(midpoints[*indices]));
+                    result = R::broadcast(coefficients[(size - 1) * stride + *indices]);
+                    for (size_t p = size - 1; p-- > 0;) {
+                        result = R::add(R::mul(dx, result),
+                                        R::broadcast(coefficients[p * stride + *indices]));
+                    }
+                } else {
+                    const auto dx = R::sub(R::load(x + i), R::gather(midpoints, indices));
+                    result = R::gather(coefficients + (size - 1) * stride, indices);
+                    for (size_t p = size - 1; p-- > 0;) {
+                        result = R::add(R::mul(dx, result),
+                                        R::gather(coefficients + p * stride, indices));
+                    }
+                }
+                R::store(out + i, result);
+            }
+        } else {
+            // Portable implementation: Blocks of fixed size with independent lanes.
+            constexpr size_t WIDTH = 8;
+            for (; i + WIDTH <= n; i += WIDTH) {
+                std::array<T, WIDTH> dx;
+                std::array<T, WIDTH> result;
+                for (size_t l = 0; l < WIDTH; l++) {
+                    dx[l] = x[i + l] - midpoints[intervals[i + l]];
+                    result[l] = coefficients[(size - 1) * stride + intervals[i + l]];
+                }
+                for (size_t p = size - 1; p-- > 0;) {
+                    const T *c = coefficients + p * stride;
+                    for (size_t l = 0; l < WIDTH; l++) {
+                        result[l] = dx[l] * result[l] + c[intervals[i + l]];
+                    }
+                }
+                for (size_t l = 0; l < WIDTH; l++) {
+                    out[i + l] = result[l];
+                }
+            }
+        }
+
+        // Remainder.
+        for (; i < n; i++) {
+            const T dx = x[i] - midpoints[intervals[i]];
+            T result = coefficients[(size - 1) * stride + intervals[i]];
+            for (size_t p = size - 1; p-- > 0;) {
+                result = dx * result + coefficients[p * stride + intervals[i]];
+            }
+            out[i] = result;
+        }
+    }
+
+}// namespace bspline::internal
+#endif// BSPLINE_DOXYGEN_IGNORE
+#endif// BSPLINE_INTERNAL_SIMD_H
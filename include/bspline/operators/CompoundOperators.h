@@ -81,6 +81,17 @@ namespace bspline::operators {
         return OperatorProduct(std::forward<O1>(o1), std::forward<O2>(o2));
     }
 
+    /*!
+ * A product of operators is translation invariant if both operators are.
+ *
+ * @tparam O1 The type of the first (left) operator.
+ * @tparam O2 The type of the second (right) operator.
+ */
+    template<typename O1, typename O2>
+    inline constexpr bool is_translation_invariant_v<OperatorProduct<O1, O2, true>> =
+            is_translation_invariant_v<std::remove_cv_t<std::remove_reference_t<O1>>> &&
+            is_translation_invariant_v<std::remove_cv_t<std::remove_reference_t<O2>>>;
+
     // ######################### OperatorProduct #############################
     // #######################################################################
 
@@ -199,6 +210,19 @@ namespace bspline::operators {
         }
     };
 
+    /*!
+ * A sum or difference of operators is translation invariant if both operators
+ * are.
+ *
+ * @tparam O1 The type of the first operator.
+ * @tparam O2 The type of the second operator.
+ * @tparam operation Indicates whether the operators are added or subtracted.
+ */
+    template<typename O1, typename O2, AdditionOperation operation>
+    inline constexpr bool is_translation_invariant_v<OperatorSum<O1, O2, operation, true>> =
+            is_translation_invariant_v<std::remove_cv_t<std::remove_reference_t<O1>>> &&
+            is_translation_invariant_v<std::remove_cv_t<std::remove_reference_t<O2>>>;
+
     /*!
  * The addition operator for two operators, returning an OperatorSum.
  *
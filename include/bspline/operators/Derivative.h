@@ -79,5 +79,13 @@ namespace bspline::operators {
     template<size_t n>
     using Dx = Derivative<n>;
 
+    /*!
+ * The derivative operators are translation invariant.
+ *
+ * @tparam n Order of the derivative.
+ */
+    template<size_t n>
+    inline constexpr bool is_translation_invariant_v<Derivative<n>> = true;
+
 }// namespace bspline::operators
 #endif// BSPLINE_OPERATORS_DERIVATIVE_H
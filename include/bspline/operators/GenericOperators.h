@@ -10,6 +10,9 @@
 
 #include <bspline/Spline.h>
 
+#include <type_traits>
+#include <utility>
+
 /*!
  * Operator definitions.
  */
@@ -42,6 +45,17 @@ namespace bspline::operators {
     template<typename O1, typename O2>
     inline constexpr bool are_operators_v = is_operator_v<O1> && is_operator_v<O2>;
 
+    /*!
+ * Indicates whether an operator commutes with translations, i.e. whether the
+ * transformation of the coefficients on an interval is independent of the
+ * position of the interval. Specialized for the translation-invariant
+ * operators.
+ *
+ * @tparam O The operator type (without cv-qualifiers and references).
+ */
+    template<typename O>
+    inline constexpr bool is_translation_invariant_v = false;
+
     /*!
  * Helper method that applies an operator to a spline based on the
  * transformation of the coefficients on a single interval.
@@ -61,7 +75,7 @@ namespace bspline::operators {
 
         const auto &oldCoefficients = spline.getCoefficients();
 
-        std::vector<std::array<T, OUTPUT_SIZE>> newCoefficients;
+        typename Spline<T, OUTPUT_SIZE - 1>::coefficients_type newCoefficients;
         newCoefficients.reserve(oldCoefficients.size());
 
         const auto &support = spline.getSupport();
@@ -75,6 +89,33 @@ namespace bspline::operators {
         return Spline(spline.getSupport(), std::move(newCoefficients));
     }
 
+    /*!
+ * Helper method that applies an operator to a temporary spline. If the
+ * operator does not change the order of the spline, the coefficients of the
+ * spline are transformed in-place and no new spline is allocated.
+ *
+ * @param op The operator to apply to the spline.
+ * @param spline The spline to apply the operator to.
+ * @tparam T The datatype of the input and output splines.
+ * @tparam order The order of the input spline.
+ * @tparam O The type of the operator.
+ * @returns The spline resulting from the application of this operator to the
+ * spline.
+ */
+    template<typename T, size_t order, typename O,
+            std::enable_if_t<is_operator_v<O>, bool> = true>
+    auto transformSpline(const O &op, Spline<T, order> &&spline) {
+        if constexpr (O::outputOrder(order) == order) {
+            const auto &grid = spline.getSupport().getGrid();
+            spline.transformCoefficients([&](const auto &coefficients, size_t absIndex) {
+                return op.transform(coefficients, grid, absIndex);
+            });
+            return std::move(spline);
+        } else {
+            return transformSpline(op, static_cast<const Spline<T, order> &>(spline));
+        }
+    }
+
     // ################## Generic Operator Definitions #######################
     // #######################################################################
 
@@ -116,7 +157,14 @@ namespace bspline::operators {
     };
 
     /*!
- * Applies an operator to a spline.
+ * The identity operator is translation invariant.
+ */
+    template<>
+    inline constexpr bool is_translation_invariant_v<IdentityOperator> = true;
+
+    /*!
+ * Applies an operator to a spline. A temporary spline is transformed in-place,
+ * if the operator does not change its order.
  *
  * @param o The operator.
  * @param s The spline.
@@ -126,9 +174,11 @@ namespace bspline::operators {
  * spline.
  */
     template<typename O, typename S,
-            std::enable_if_t<is_operator_v<O> && is_spline_v<S>, bool> = true>
-    auto operator*(const O &o, const S &s) {
-        return transformSpline(o, s);
+            std::enable_if_t<is_operator_v<O> &&
+                                     is_spline_v<std::remove_cv_t<std::remove_reference_t<S>>>,
+                             bool> = true>
+    auto operator*(const O &o, S &&s) {
+        return transformSpline(o, std::forward<S>(s));
     }
 }// namespace bspline::operators
 #endif// BSPLINE_OPERATORS_GENERICOPERATORS_H
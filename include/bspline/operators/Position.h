@@ -73,8 +73,7 @@ namespace bspline::operators {
                 size_t intervalIndex) const {
             constexpr size_t OUTPUT_SIZE = size + n;
 
-            const T xm =
-                    (grid[intervalIndex] + grid[intervalIndex + 1]) / static_cast<T>(2);
+            const T &xm = grid.midpoint(intervalIndex);
 
             const std::array<T, n + 1> expanded = expandPower<T>(xm);
 
@@ -9,6 +9,7 @@
 #define BSPLINE_OPERATORS_SCALAROPERATORS_H
 
 #include <bspline/Spline.h>
+#include <bspline/SplineView.h>
 #include <bspline/operators/CompoundOperators.h>
 
 /*!
@@ -25,7 +26,7 @@ namespace bspline::operators {
  */
     template<typename T, typename O>
     inline constexpr bool are_scalar_multiplication_types_v =
-            !is_spline_v<T> && !is_operator_v<T> && is_operator_v<O>;
+            !is_spline_or_view_v<T> && !is_operator_v<T> && is_operator_v<O>;
 
     /*!
  * Represents the multiplication of an operator with a scalar.
@@ -104,6 +105,16 @@ namespace bspline::operators {
     template<typename S>
     ScalarMultiplication(S s) -> ScalarMultiplication<S, IdentityOperator>;
 
+    /*!
+ * A scaled operator is translation invariant if the operator is.
+ *
+ * @tparam S The type of the scalar.
+ * @tparam O The type of the operator.
+ */
+    template<typename S, typename O>
+    inline constexpr bool is_translation_invariant_v<ScalarMultiplication<S, O, true>> =
+            is_translation_invariant_v<std::remove_cv_t<std::remove_reference_t<O>>>;
+
     /*!
  * The scalar multiplication operator for an operator.
  *
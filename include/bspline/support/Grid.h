@@ -9,11 +9,13 @@
 #define BSPLINE_SUPPORT_GRID_H
 
 #include <bspline/exceptions/BSplineException.h>
+#include <bspline/internal/GridCache.h>
 #include <bspline/internal/misc.h>
 #include <bspline/internal/test_checks.h>
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace bspline::support {
@@ -27,8 +29,39 @@ namespace bspline::support {
     template<typename T>
     class Grid final {
     private:
-        /*! The gridpoints. */
-        std::shared_ptr<const std::vector<T>> _data;
+        /*!
+   * The grid points together with the data speeding up queries on them. Both
+   * share a single allocation and reference count, so copying a grid costs a
+   * single atomic increment. Grid points passed as a shared pointer are not
+   * copied, but referenced.
+   */
+        struct Impl {
+            /*! The gridpoints, if owned by the grid. */
+            const std::vector<T> ownedPoints;
+
+            /*! The gridpoints, if shared with the creator of the grid. */
+            const std::shared_ptr<const std::vector<T>> sharedPoints;
+
+            /*! Lazily built data speeding up queries, shared between copies. */
+            mutable internal::GridCache<T> cache;
+
+            explicit Impl(std::vector<T> p) : ownedPoints(std::move(p)) {}
+
+            explicit Impl(std::shared_ptr<const std::vector<T>> p)
+                : sharedPoints(std::move(p)) {}
+
+            Impl(const Impl &) = delete;
+
+            Impl &operator=(const Impl &) = delete;
+
+            /*! Returns the gridpoints. */
+            const std::vector<T> &points() const {
+                return sharedPoints ? *sharedPoints : ownedPoints;
+            }
+        };
+
+        /*! The shared grid points and cache. */
+        std::shared_ptr<const Impl> _impl;
 
         /*!
    * Checks whether grid points are steadily increasing.
@@ -36,8 +69,9 @@ namespace bspline::support {
    * @returns True if the grid points are steadily increasing, false otherwise.
    */
         bool isSteadilyIncreasing() const {
-            for (size_t i = 1; i < _data->size(); i++) {
-                if ((*_data)[i - 1] >= (*_data)[i]) {
+            const std::vector<T> &points = _impl->points();
+            for (size_t i = 1; i < points.size(); i++) {
+                if (points[i - 1] >= points[i]) {
                     return false;
                 }
             }
@@ -52,7 +86,7 @@ namespace bspline::support {
    */
         void checkValidity() const {
             // Check the validity of the provided data.
-            if (!_data || _data->size() < 2) {
+            if (!_impl || _impl->points().size() < 2) {
                 throw BSplineException(ErrorCode::MISSING_DATA);
             } else if (!isSteadilyIncreasing()) {
                 throw BSplineException(ErrorCode::INCONSISTENT_DATA,
@@ -80,8 +114,7 @@ namespace bspline::support {
    * single element, or if the elements are not in steadily increasing order.
    */
         template<typename Iter>
-        Grid(Iter begin, Iter end)
-                : Grid(std::make_shared<const std::vector<T>>(begin, end)) {}
+        Grid(Iter begin, Iter end) : Grid(std::vector<T>(begin, end)) {}
 
         /*!
    * Constructs a grid from a std::vector.
@@ -90,8 +123,9 @@ namespace bspline::support {
    * @throws BSplineException If the grid is empty or contains only a
    * single element, or if the elements are not in steadily increasing order.
    */
-        explicit Grid(std::vector<T> v)
-                : Grid(std::make_shared<const std::vector<T>>(std::move(v))) {};
+        explicit Grid(std::vector<T> v) : _impl(std::make_shared<const Impl>(std::move(v))) {
+            checkValidity();
+        };
 
         /*!
    * Constructs a grid from a std::initializer_list.
@@ -103,14 +137,15 @@ namespace bspline::support {
         explicit Grid(const std::initializer_list<T> &v) : Grid(v.begin(), v.end()) {};
 
         /*!
-   * Constructs a grid from a std::shared_ptr<const std::vector<T>>.
+   * Constructs a grid from a std::shared_ptr<const std::vector<T>>. The grid
+   * elements are not copied, the grid shares ownership of them.
    *
    * @param data A shared pointer to the grid elements.
    * @throws BSplineException If the grid is empty or contains only a
    * single element, or if the elements are not in steadily increasing order.
    */
-        explicit Grid(std::shared_ptr<const std::vector<T>> data)
-                : _data(std::move(data)) {
+        explicit Grid(const std::shared_ptr<const std::vector<T>> &data)
+            : _impl(data ? std::make_shared<const Impl>(data) : nullptr) {
             checkValidity();
         };
 
@@ -156,13 +191,13 @@ namespace bspline::support {
         bool operator==(const Grid &g) const {
             DURING_TEST_CHECK_VALIDITY();
             DURING_TEST_CHECK_VALIDITY_OF(g);
-            if (_data == g._data) {
+            if (_impl == g._impl || &_impl->points() == &g._impl->points()) {
                 // Fast path: Compare pointers.
                 return true;
             }
 
             // Slow path: Compare logically.
-            return (*_data) == (*g._data);
+            return _impl->points() == g._impl->points();
         }
 
         /*!
@@ -180,17 +215,19 @@ namespace bspline::support {
    */
         size_t size() const {
             DURING_TEST_CHECK_VALIDITY();
-            return _data->size();
+            return _impl->points().size();
         };
 
         /*!
-   * Returns a shared pointer to the elements of this grid.
+   * Returns a shared pointer to the elements of this grid. The pointer shares
+   * ownership with this grid.
    *
    * @returns A shared pointer to the elements of this grid.
    */
         std::shared_ptr<const std::vector<T>> getData() const {
             DURING_TEST_CHECK_VALIDITY();
-            return _data;
+            if (_impl->sharedPoints) return _impl->sharedPoints;
+            return std::shared_ptr<const std::vector<T>>(_impl, &_impl->ownedPoints);
         };
 
         /*!
@@ -201,7 +238,7 @@ namespace bspline::support {
    */
         bool empty() const {
             DURING_TEST_CHECK_VALIDITY();
-            return _data->empty();
+            return _impl->points().empty();
         };
 
         /*!
@@ -213,7 +250,7 @@ namespace bspline::support {
    */
         const T &operator[](size_t i) const {
             DURING_TEST_CHECK_VALIDITY();
-            return (*_data)[i];
+            return _impl->points()[i];
         };
 
         /*!
@@ -228,7 +265,7 @@ namespace bspline::support {
             if (i >= size()) {
                 throw BSplineException(ErrorCode::INVALID_ACCESS);
             }
-            return (*_data)[i];
+            return _impl->points()[i];
         };
 
         /*!
@@ -242,7 +279,7 @@ namespace bspline::support {
             if (empty()) {
                 throw BSplineException(ErrorCode::INVALID_ACCESS);
             }
-            return _data->front();
+            return _impl->points().front();
         };
 
         /*!
@@ -256,7 +293,7 @@ namespace bspline::support {
             if (empty()) {
                 throw BSplineException(ErrorCode::INVALID_ACCESS);
             }
-            return _data->back();
+            return _impl->points().back();
         };
 
         /*!
@@ -266,7 +303,7 @@ namespace bspline::support {
    */
         const_iterator begin() const {
             DURING_TEST_CHECK_VALIDITY();
-            return _data->begin();
+            return _impl->points().begin();
         };
 
         /*!
@@ -276,7 +313,7 @@ namespace bspline::support {
    */
         const_iterator end() const {
             DURING_TEST_CHECK_VALIDITY();
-            return _data->end();
+            return _impl->points().end();
         };
 
         /*!
@@ -287,17 +324,75 @@ namespace bspline::support {
    */
         size_t findElement(const T &x) const {
             DURING_TEST_CHECK_VALIDITY();
-            const auto beginIt = begin();
-            const auto endIt = end();
-            const auto elementIt = std::lower_bound(beginIt, endIt, x);
+            const auto intervalIndex = findInterval(x);
 
-            if (elementIt == endIt || *elementIt != x) {
+            if (intervalIndex && _impl->points()[*intervalIndex] == x) {
+                return *intervalIndex;
+            } else if (intervalIndex && _impl->points()[*intervalIndex + 1] == x) {
+                return *intervalIndex + 1;
+            } else {
                 // Element was not found
                 throw BSplineException(ErrorCode::INCONSISTENT_DATA);
-            } else {
-                return std::distance(beginIt, elementIt);
             }
         };
+
+        /*!
+   * Finds the interval in which x lies. An interval contains its right
+   * boundary, the first interval of the grid also its left boundary. If the
+   * grid points are equally spaced, the interval is determined by index
+   * arithmetic. Otherwise, a binary search is performed, which operates on a
+   * cache-friendly copy of the grid points for large grids.
+   *
+   * @param x The point to search for.
+   * @returns The index of the grid point at the beginning of the interval
+   * containing x or std::nullopt if x is not part of the grid.
+   */
+        std::optional<size_t> findInterval(const T &x) const {
+            DURING_TEST_CHECK_VALIDITY();
+            if (!(x >= _impl->points().front() && x <= _impl->points().back())) {
+                return std::nullopt;
+            }
+            return _impl->cache.findInterval(_impl->points(), x);
+        };
+
+        /*!
+   * Returns the midpoint of the interval beginning at grid point i. The
+   * midpoints of all intervals are computed once and shared between all copies
+   * of the grid. Performs no bounds checks.
+   *
+   * @param i The index of the grid point at the beginning of the interval. Must
+   * be smaller than size() - 1.
+   * @returns The midpoint of the interval.
+   */
+        const T &midpoint(size_t i) const {
+            DURING_TEST_CHECK_VALIDITY();
+            return _impl->cache.getMidpoints(_impl->points())[i];
+        };
+
+        /*!
+   * Returns the half width of the interval beginning at grid point i. The half
+   * widths of all intervals are computed once and shared between all copies of
+   * the grid. Performs no bounds checks.
+   *
+   * @param i The index of the grid point at the beginning of the interval. Must
+   * be smaller than size() - 1.
+   * @returns The half width of the interval.
+   */
+        const T &halfWidth(size_t i) const {
+            DURING_TEST_CHECK_VALIDITY();
+            return _impl->cache.getHalfWidths(_impl->points())[i];
+        };
+
+        /*!
+   * Checks whether the grid points are (approximately) equally spaced, in
+   * which case findInterval() does not require a binary search.
+   *
+   * @returns True if the grid points are equally spaced.
+   */
+        bool isUniform() const {
+            DURING_TEST_CHECK_VALIDITY();
+            return _impl->cache.isUniform(_impl->points());
+        };
     };
 }// namespace bspline::support
 #endif// BSPLINE_SUPPORT_GRID_H
@@ -0,0 +1,91 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_SUPPORT_GRIDCURSOR_H
+#define BSPLINE_SUPPORT_GRIDCURSOR_H
+
+#include <bspline/support/Grid.h>
+
+#include <optional>
+
+namespace bspline::support {
+
+    /*!
+ * Locates points on a global grid, remembering the interval of the previous
+ * query. If the points are queried in (roughly) monotone order, the interval
+ * is usually found by checking the previous interval and its neighbors,
+ * without any search.
+ *
+ * @tparam T The datatype of the grid elements.
+ */
+    template<typename T>
+    class GridCursor final {
+    private:
+        /*! The global grid. */
+        Grid<T> _grid;
+        /*! The interval found by the previous query. */
+        size_t _intervalIndex = 0;
+
+        /*!
+   * Checks whether x lies in the interval beginning at the grid point
+   * intervalIndex. Uses the same convention as Grid::findInterval().
+   *
+   * @param x The point to check.
+   * @param intervalIndex The index of the interval.
+   * @returns True if x lies in the interval.
+   */
+        bool isInInterval(const T &x, size_t intervalIndex) const {
+            return (x > _grid[intervalIndex] ||
+                    (intervalIndex == 0 && x == _grid[intervalIndex])) &&
+                   x <= _grid[intervalIndex + 1];
+        }
+
+    public:
+        /*!
+   * Constructs a cursor on the global grid.
+   *
+   * @param grid The global grid.
+   */
+        explicit GridCursor(const Grid<T> &grid) : _grid(grid) {};
+
+        /*!
+   * Returns the global grid.
+   *
+   * @returns A reference to the global grid.
+   */
+        const Grid<T> &getGrid() const { return _grid; };
+
+        /*!
+   * Finds the interval in which x lies. The interval of the previous query and
+   * its two neighbors are checked first, before falling back to
+   * Grid::findInterval().
+   *
+   * @param x The point to search for.
+   * @returns The index of the grid point at the beginning of the interval
+   * containing x or std::nullopt if x is not part of the grid.
+   */
+        std::optional<size_t> findInterval(const T &x) {
+            const size_t numberOfIntervals = _grid.size() - 1;
+
+            if (isInInterval(x, _intervalIndex)) {
+                return _intervalIndex;
+            } else if (_intervalIndex + 1 < numberOfIntervals &&
+                       isInInterval(x, _intervalIndex + 1)) {
+                return ++_intervalIndex;
+            } else if (_intervalIndex > 0 && isInInterval(x, _intervalIndex - 1)) {
+                return --_intervalIndex;
+            }
+
+            const auto intervalIndex = _grid.findInterval(x);
+            if (intervalIndex) {
+                _intervalIndex = *intervalIndex;
+            }
+            return intervalIndex;
+        };
+    };
+}// namespace bspline::support
+#endif// BSPLINE_SUPPORT_GRIDCURSOR_H
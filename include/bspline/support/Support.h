@@ -241,6 +241,24 @@ namespace bspline::support {
             return index + _startIndex;
         };
 
+        /*!
+   * Finds the interval of this support in which x lies. An interval contains
+   * its right boundary, the first interval of the support also its left
+   * boundary.
+   *
+   * @param x The point to search for.
+   * @returns The index of the interval relative to this support or
+   * std::nullopt if x is not part of this support.
+   */
+        std::optional<RelativeIndex> findInterval(const T &x) const {
+            DURING_TEST_CHECK_VALIDITY();
+            if (!containsIntervals() || x < front() || x > back()) {
+                return std::nullopt;
+            }
+            const AbsoluteIndex absoluteIndex = _grid.findInterval(x).value();
+            return std::max(absoluteIndex, _startIndex) - _startIndex;
+        };
+
         /*!
    * Returns the number of intervals represented by this support.
    *
@@ -299,6 +317,30 @@ namespace bspline::support {
             return _grid[_startIndex + index];
         };
 
+        /*!
+   * Returns the midpoint of the interval beginning at the index-th grid point of
+   * the support. Performs no bounds checks.
+   *
+   * @param index Relative index of the interval.
+   * @returns The midpoint of the interval, as cached by the grid.
+   */
+        const T &intervalMidpoint(RelativeIndex index) const {
+            DURING_TEST_CHECK_VALIDITY();
+            return _grid.midpoint(_startIndex + index);
+        };
+
+        /*!
+   * Returns the half width of the interval beginning at the index-th grid point
+   * of the support. Performs no bounds checks.
+   *
+   * @param index Relative index of the interval.
+   * @returns The half width of the interval, as cached by the grid.
+   */
+        const T &intervalHalfWidth(RelativeIndex index) const {
+            DURING_TEST_CHECK_VALIDITY();
+            return _grid.halfWidth(_startIndex + index);
+        };
+
         /*!
    * Allows access to the grid points contained in the support. Checks bounds
    * and throws exception in case of out-of-bounds access.
@@ -31,12 +31,14 @@ using DeMat = Eigen::Matrix<data_t, Eigen::Dynamic, Eigen::Dynamic>;
 template<typename B, typename data_t, size_t order>
 DeMat<data_t> setUpSymmetricMatrix(
         const B &b, const std::vector<Spline<data_t, order>> &basis) {
+    const SparseMatrix<data_t> sparse = b.assemble(basis);
     DeMat<data_t> ret = DeMat<data_t>::Zero(basis.size(), basis.size());
-    for (size_t i = 0; i < basis.size(); i++) {
-        for (size_t j = i; j < basis.size(); j++) {
-            const data_t val = b.evaluate(basis.at(i), basis.at(j));
-            ret(i, j) = val;
-            ret(j, i) = val;
+    for (size_t i = 0; i < sparse.rows; i++) {
+        for (size_t k = sparse.rowOffsets[i]; k < sparse.rowOffsets[i + 1]; k++) {
+            const size_t j = sparse.columnIndices[k];
+            if (j < i) continue;
+            ret(i, j) = sparse.values[k];
+            ret(j, i) = sparse.values[k];
         }
     }
     return ret;
@@ -0,0 +1,157 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#include <bspline/BSplineBasis.h>
+#include <bspline/BSplineGenerator.h>
+#include <bspline/CollocationMatrix.h>
+#include <bspline/ParallelEvaluator.h>
+#include <bspline/SoASpline.h>
+#include <bspline/SplineCursor.h>
+#include <bspline/integration/BilinearForm.h>
+#include <bspline/testData.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <iterator>
+#include <memory_resource>
+
+using namespace bspline;
+
+/*!
+ * Checks that a basis of BSplines yields the same results as the vector of
+ * splines it was generated from, when passed to the APIs accepting
+ * collections of splines.
+ *
+ * @param xs The points at which the splines are evaluated.
+ */
+template<typename T, size_t order>
+static void testBasis(const std::vector<T> &xs) {
+    const auto splines = generateBSplines<order>(DEFAULT_GRID_DATA);
+    const auto basis = generateBasis<order>(DEFAULT_GRID_DATA);
+
+    BOOST_REQUIRE(basis.size() == splines.size());
+    BOOST_TEST(static_cast<size_t>(std::distance(basis.begin(), basis.end())) == splines.size());
+    BOOST_TEST((basis.toSplines() == splines));
+    BOOST_TEST((BSplineBasis(splines).toSplines() == splines));
+
+    const integration::ScalarProduct scalarProduct;
+    size_t i = 0;
+    for (auto it = basis.begin(); it != basis.end(); it++, i++) {
+        const auto &neighbour = splines[(i + 1) % splines.size()];
+        BOOST_TEST((it->getSupport() == splines[i].getSupport()));
+        BOOST_TEST(((*it).toSpline() == splines[i]));
+        BOOST_TEST(basis.at(i).evaluate(xs) == splines[i].evaluate(xs), boost::test_tools::per_element());
+        BOOST_TEST((SoASpline(basis[i]).toSpline() == splines[i]));
+        BOOST_TEST(scalarProduct.evaluate(basis[i], basis[(i + 1) % basis.size()]) ==
+                   scalarProduct.evaluate(splines[i], neighbour));
+    }
+
+    ParallelEvaluator evaluator(2);
+    BOOST_TEST(evaluator.tabulate(basis, xs) == evaluator.tabulate(splines, xs),
+               boost::test_tools::per_element());
+
+    const auto basisMatrix = collocationMatrix(basis, xs);
+    const auto splinesMatrix = collocationMatrix(splines, xs);
+    BOOST_TEST(basisMatrix.rowOffsets == splinesMatrix.rowOffsets, boost::test_tools::per_element());
+    BOOST_TEST(basisMatrix.columnIndices == splinesMatrix.columnIndices, boost::test_tools::per_element());
+    BOOST_TEST(basisMatrix.values == splinesMatrix.values, boost::test_tools::per_element());
+
+    SplineCursor basisCursor(basis);
+    SplineCursor splinesCursor(splines);
+    for (const T &x: xs) {
+        BOOST_TEST(basisCursor.evaluate(x) == splinesCursor.evaluate(x), boost::test_tools::per_element());
+    }
+
+    std::vector<T> coeffs(splines.size());
+    for (size_t j = 0; j < coeffs.size(); j++) {
+        coeffs[j] = static_cast<T>(j % 5) - static_cast<T>(2);
+    }
+    BOOST_TEST((linearCombination(coeffs, basis) == linearCombination(coeffs, splines)));
+}
+
+BOOST_AUTO_TEST_SUITE(BSplineBasisTestSuite)
+
+/*!
+ * Passes if a basis of BSplines behaves as the vector of the same splines.
+ */
+BOOST_AUTO_TEST_CASE(BasisMatchesSplines) {
+        const std::vector<double> xs = testPoints(0.01);
+        testBasis<double, 0>(xs);
+        testBasis<double, 3>(xs);
+        testBasis<double, 7>(xs);
+}
+
+/*!
+ * Passes if the coefficients of all splines are stored contiguously, the
+ * views referring to the grid of the basis instead of copies of it.
+ */
+BOOST_AUTO_TEST_CASE(ContiguousStorage) {
+        const auto basis = generateBasis<3>(DEFAULT_GRID_DATA);
+        size_t offset = 0;
+        for (const auto &view: basis) {
+                BOOST_TEST(view.getCoefficients() == basis.getCoefficients().data() + offset);
+                BOOST_TEST(&view.getGrid() == &basis.getGrid());
+                BOOST_TEST((view.getSupport() ==
+                            Support<double>(basis.getGrid(), view.getStartIndex(), view.getEndIndex())));
+                offset += view.numberOfIntervals();
+        }
+        BOOST_TEST(offset == basis.getCoefficients().size());
+}
+
+/*!
+ * Passes if moving a basis keeps its block of coefficients, the memory resource
+ * of the block and the grid, such that views taken before the move stay valid.
+ */
+BOOST_AUTO_TEST_CASE(MoveKeepsStorage) {
+        std::pmr::monotonic_buffer_resource arena;
+        auto basis = generateBasis<3>(DEFAULT_GRID_DATA, &arena);
+        const auto *coefficients = basis.getCoefficients().data();
+        const Grid<double> *grid = &basis.getGrid();
+        const auto view = basis[4];
+        const auto expected = generateBSplines<3>(DEFAULT_GRID_DATA)[4];
+
+        BSplineBasis<double, 3> moved(std::move(basis));
+        BOOST_TEST(moved.getCoefficients().data() == coefficients);
+        BOOST_TEST(moved.getCoefficients().get_allocator().resource() == &arena);
+        BOOST_TEST(&moved.getGrid() == grid);
+        BOOST_TEST((view.toSpline() == expected));
+
+        auto assigned = generateBasis<3>(DEFAULT_GRID_DATA, &arena);
+        assigned = std::move(moved);
+        BOOST_TEST(assigned.getCoefficients().data() == coefficients);
+        BOOST_TEST(&assigned.getGrid() == grid);
+        BOOST_TEST((view.toSpline() == expected));
+
+        auto transformed = integration::ScalarProduct().transform(assigned);
+        const Grid<double> *transformedGrid = &transformed.getGrid();
+        const double *halfWidths = &transformedGrid->halfWidth(0);
+        const auto movedTransformed(std::move(transformed));
+        BOOST_TEST(&movedTransformed.getGrid() == transformedGrid);
+        BOOST_TEST(&movedTransformed.getGrid().halfWidth(0) == halfWidths);
+}
+
+/*!
+ * Passes if empty collections, splines on different grids and accesses out of
+ * bounds are rejected.
+ */
+BOOST_AUTO_TEST_CASE(BasisThrows) {
+        using bspline::exceptions::BSplineException;
+        using Basis = BSplineBasis<double, 2>;
+        const std::vector<Spline<double, 2>> empty;
+        BOOST_REQUIRE_THROW(Basis{empty}, BSplineException);
+
+        auto differentGrids = generateBSplines<2>(DEFAULT_GRID_DATA);
+        std::vector<double> otherKnots(DEFAULT_GRID_DATA);
+        otherKnots.back() += 1.0;
+        differentGrids.push_back(generateBSplines<2>(otherKnots).front());
+        BOOST_REQUIRE_THROW(Basis{differentGrids}, BSplineException);
+
+        const auto basis = generateBasis<2>(DEFAULT_GRID_DATA);
+        BOOST_REQUIRE_THROW(basis.at(basis.size()), BSplineException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
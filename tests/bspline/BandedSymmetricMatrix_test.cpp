@@ -0,0 +1,150 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#include <bspline/BSplineGenerator.h>
+#include <bspline/BandedSymmetricMatrix.h>
+#include <bspline/integration/BilinearForm.h>
+#include <bspline/operators/CompoundOperators.h>
+#include <bspline/operators/Derivative.h>
+#include <bspline/operators/Position.h>
+#include <bspline/testData.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace bspline;
+using namespace bspline::operators;
+
+/*!
+ * Solves a linear system with a right hand side computed from a known solution.
+ *
+ * @param matrix The matrix, which is factorized by the function.
+ * @param cholesky Whether to use the Cholesky or the LDL^T factorization.
+ */
+static void testSolve(BandedSymmetricMatrix<double> matrix, bool cholesky) {
+    std::vector<double> x;
+    for (size_t i = 0; i < matrix.size(); i++) {
+        x.push_back(std::cos(0.7 * static_cast<double>(i)) + 0.5);
+    }
+    const std::vector<double> b = matrix.multiply(x);
+    if (cholesky) {
+        matrix.factorizeCholesky();
+    } else {
+        matrix.factorizeLDLT();
+    }
+    const std::vector<double> solution = matrix.solve(b);
+
+    BOOST_REQUIRE(solution.size() == x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        BOOST_CHECK_SMALL(solution[i] - x[i], 1.0e-9);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BandedSymmetricMatrixTestSuite)
+
+/*!
+ * Passes if the elements are stored in band storage and accessed
+ * symmetrically.
+ */
+BOOST_AUTO_TEST_CASE(BandStorage) {
+        BandedSymmetricMatrix<double> matrix(5, 2);
+        matrix(3, 1) = 4.0;
+        matrix(0, 2) = 2.0;
+        matrix(4, 4) = 1.0;
+
+        BOOST_TEST(matrix.size() == 5);
+        BOOST_TEST(matrix.bandwidth() == 2);
+        BOOST_TEST(matrix.getBandStorage().size() == 15);
+        BOOST_TEST(matrix.getBandStorage()[2 + 1 * 3] == 4.0);
+        BOOST_TEST(matrix.getBandStorage()[2 + 0 * 3] == 2.0);
+        BOOST_TEST(matrix.getBandStorage()[0 + 4 * 3] == 1.0);
+        BOOST_TEST(matrix.at(1, 3) == 4.0);
+        BOOST_TEST(matrix.at(2, 0) == 2.0);
+        BOOST_TEST(matrix.at(4, 0) == 0.0);
+        BOOST_REQUIRE_THROW(matrix.at(5, 0), bspline::exceptions::BSplineException);
+}
+
+/*!
+ * Passes if the matrices of bilinear forms over B-splines are copied into
+ * band storage and the linear systems are solved by both factorizations.
+ */
+BOOST_AUTO_TEST_CASE(SolveBilinearForms) {
+        const std::vector<double> knots = clampedKnots(3, true);
+        const auto splines = generateBSplines<3>(knots);
+
+        const integration::ScalarProduct scalarProduct;
+        const auto overlap = scalarProduct.assemble(splines);
+        const BandedSymmetricMatrix<double> overlapMatrix(overlap);
+        BOOST_TEST(overlapMatrix.size() == splines.size());
+        BOOST_TEST(overlapMatrix.bandwidth() == 3);
+        for (size_t i = 0; i < splines.size(); i++) {
+                for (size_t j = 0; j < splines.size(); j++) {
+                        BOOST_TEST(overlapMatrix.at(i, j) == overlap.at(std::max(i, j), std::min(i, j)));
+                }
+        }
+        testSolve(overlapMatrix, true);
+        testSolve(overlapMatrix, false);
+
+        // The harmonic oscillator shifted by -3.0 is indefinite.
+        const integration::BilinearForm shifted{0.5 * (-Dx<2>{} + X<2>{})};
+        BandedSymmetricMatrix<double> indefinite(shifted.assemble(splines));
+        const BandedSymmetricMatrix<double> overlapCopy(overlap);
+        for (size_t j = 0; j < indefinite.size(); j++) {
+                for (size_t i = j; i < std::min(indefinite.size(), j + 4); i++) {
+                        indefinite(i, j) -= 3.0 * overlapCopy(i, j);
+                }
+        }
+        testSolve(indefinite, false);
+        BOOST_REQUIRE_THROW(indefinite.factorizeCholesky(), bspline::exceptions::BSplineException);
+}
+
+/*!
+ * Passes if singular matrices, non-square matrices and operations in the
+ * wrong factorization state, including after a failed factorization, are
+ * rejected.
+ */
+BOOST_AUTO_TEST_CASE(BandedSymmetricMatrixThrows) {
+        using BSplineException = bspline::exceptions::BSplineException;
+
+        BandedSymmetricMatrix<double> singular(3, 1);
+        BOOST_REQUIRE_THROW(singular.factorizeLDLT(), BSplineException);
+        BOOST_REQUIRE_THROW(singular.factorizeCholesky(), BSplineException);
+
+        BandedSymmetricMatrix<double> matrix(3, 1);
+        for (size_t i = 0; i < 3; i++) matrix(i, i) = 2.0;
+        BOOST_REQUIRE_THROW(matrix.solve(std::vector<double>(3, 1.0)), BSplineException);
+        matrix.factorizeCholesky();
+        BOOST_REQUIRE_THROW(matrix.factorizeLDLT(), BSplineException);
+        BOOST_REQUIRE_THROW(matrix.multiply(std::vector<double>(3, 1.0)), BSplineException);
+        BOOST_REQUIRE_THROW(matrix.solve(std::vector<double>(2, 1.0)), BSplineException);
+        BOOST_TEST(std::abs(matrix.solve(std::vector<double>(3, 1.0)).at(1) - 0.5) < 1.0e-15);
+
+        // The failure in the second column leaves the first column factorized.
+        BandedSymmetricMatrix<double> indefinite(3, 1);
+        indefinite(0, 0) = 4.0;
+        indefinite(1, 0) = 2.0;
+        indefinite(1, 1) = -1.0;
+        indefinite(2, 2) = 1.0;
+        BOOST_REQUIRE_THROW(indefinite.factorizeCholesky(), BSplineException);
+        BOOST_TEST((indefinite.getFactorization() ==
+                    BandedSymmetricMatrix<double>::Factorization::FAILED));
+        BOOST_REQUIRE_THROW(indefinite.at(1, 0), BSplineException);
+        BOOST_REQUIRE_THROW(indefinite.multiply(std::vector<double>(3, 1.0)), BSplineException);
+        BOOST_REQUIRE_THROW(indefinite.solve(std::vector<double>(3, 1.0)), BSplineException);
+        BOOST_REQUIRE_THROW(indefinite.factorizeLDLT(), BSplineException);
+        BOOST_REQUIRE_THROW(indefinite.factorizeCholesky(), BSplineException);
+
+        SparseMatrix<double> rectangular;
+        rectangular.rows = 2;
+        rectangular.cols = 3;
+        rectangular.rowOffsets = {0, 0, 0};
+        BOOST_REQUIRE_THROW(BandedSymmetricMatrix<double>{rectangular}, BSplineException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
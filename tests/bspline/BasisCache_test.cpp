@@ -0,0 +1,169 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#include <bspline/BasisCache.h>
+#include <bspline/testData.h>
+
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace bspline;
+
+BOOST_AUTO_TEST_SUITE(BasisCacheTestSuite)
+
+/*!
+ * Passes if repeated requests share the cached basis, which coincides with
+ * the generated one, and different knots vectors, orders and data types are
+ * cached separately.
+ */
+BOOST_AUTO_TEST_CASE(CacheHitsAndMisses) {
+        BasisCache cache(1 << 20);
+        const auto basis = cache.getBasis<3>(DEFAULT_GRID_DATA);
+        BOOST_TEST(cache.misses() == 1);
+        BOOST_TEST(cache.hits() == 0);
+        BOOST_TEST((basis->toSplines() == generateBSplines<3>(DEFAULT_GRID_DATA)));
+
+        BOOST_TEST((cache.getBasis<3>(DEFAULT_GRID_DATA) == basis));
+        BOOST_TEST(cache.hits() == 1);
+
+        std::vector<double> otherKnots(DEFAULT_GRID_DATA);
+        otherKnots.back() += 1.0;
+        cache.getBasis<3>(otherKnots);
+        cache.getBasis<2>(DEFAULT_GRID_DATA);
+        const std::vector<float> floatKnots(DEFAULT_GRID_DATA.begin(), DEFAULT_GRID_DATA.end());
+        cache.getBasis<3>(floatKnots);
+        BOOST_TEST(cache.misses() == 4);
+        BOOST_TEST(cache.hits() == 1);
+        BOOST_TEST(cache.size() == 4);
+        BOOST_TEST(cache.memoryUsage() <= cache.maxMemoryUsage());
+
+        cache.clear();
+        BOOST_TEST(cache.size() == 0);
+        BOOST_TEST(cache.memoryUsage() == 0);
+        BOOST_TEST((cache.getBasis<3>(DEFAULT_GRID_DATA) != basis));
+        BOOST_TEST(cache.misses() == 5);
+}
+
+/*!
+ * Passes if a cache miss moves the generated basis into the cache instead of
+ * copying its coefficients, i.e. it allocates from the default resource as
+ * often as generating the basis alone.
+ */
+BOOST_AUTO_TEST_CASE(MissDoesNotCopy) {
+        CountingResource counter(std::pmr::new_delete_resource());
+        std::pmr::memory_resource *previousDefault = std::pmr::set_default_resource(&counter);
+
+        const auto generated = generateBasis<3>(DEFAULT_GRID_DATA);
+        const size_t generatorAllocations = counter.allocations;
+        BasisCache cache(1 << 20);
+        const auto basis = cache.getBasis<3>(DEFAULT_GRID_DATA);
+        BOOST_TEST(counter.allocations == 2 * generatorAllocations);
+        BOOST_TEST(basis->getCoefficients().get_allocator().resource() == &counter);
+
+        std::pmr::set_default_resource(previousDefault);
+}
+
+/*!
+ * Passes if the least recently used bases are evicted once the memory bound
+ * is exceeded, and bases larger than the bound are not cached.
+ */
+BOOST_AUTO_TEST_CASE(LeastRecentlyUsedEviction) {
+        std::vector<std::vector<double>> knots(3, DEFAULT_GRID_DATA);
+        for (size_t i = 0; i < knots.size(); i++) {
+                knots[i].back() += static_cast<double>(i + 1);
+        }
+
+        BasisCache probe(1 << 20);
+        probe.getBasis<3>(knots[0]);
+        const size_t bytes = probe.memoryUsage();
+
+        // Room for two bases.
+        BasisCache cache(2 * bytes + bytes / 2);
+        cache.getBasis<3>(knots[0]);
+        cache.getBasis<3>(knots[1]);
+        cache.getBasis<3>(knots[0]);
+        cache.getBasis<3>(knots[2]);// Evicts knots[1].
+        BOOST_TEST(cache.size() == 2);
+        BOOST_TEST(cache.memoryUsage() <= cache.maxMemoryUsage());
+
+        cache.getBasis<3>(knots[0]);
+        cache.getBasis<3>(knots[2]);
+        BOOST_TEST(cache.hits() == 3);
+        cache.getBasis<3>(knots[1]);
+        BOOST_TEST(cache.misses() == 4);
+
+        BasisCache tooSmall(bytes / 2);
+        const auto basis = tooSmall.getBasis<3>(knots[0]);
+        BOOST_TEST(basis->size() == knots[0].size() - 4);
+        BOOST_TEST(tooSmall.size() == 0);
+        BOOST_TEST(tooSmall.memoryUsage() == 0);
+}
+
+/*!
+ * Passes if concurrent requests for the same basis all obtain the cached
+ * instance once it is cached and the counters add up.
+ */
+BOOST_AUTO_TEST_CASE(ConcurrentRequests) {
+        BasisCache cache(1 << 20);
+        const auto expected = cache.getBasis<3>(DEFAULT_GRID_DATA);
+
+        static constexpr size_t N_THREADS = 4;
+        static constexpr size_t N_REQUESTS = 100;
+        std::vector<std::thread> threads;
+        std::vector<char> shared(N_THREADS, 1);
+        for (size_t t = 0; t < N_THREADS; t++) {
+                threads.emplace_back([&, t]() {
+                        for (size_t i = 0; i < N_REQUESTS; i++) {
+                                shared[t] = shared[t] && cache.getBasis<3>(DEFAULT_GRID_DATA) == expected;
+                                cache.getBasis<2>(DEFAULT_GRID_DATA);
+                        }
+                });
+        }
+        for (auto &thread: threads) {
+                thread.join();
+        }
+
+        BOOST_TEST((shared == std::vector<char>(N_THREADS, 1)));
+        BOOST_TEST(cache.hits() + cache.misses() == 2 * N_THREADS * N_REQUESTS + 1);
+        BOOST_TEST(cache.size() == 2);
+}
+
+/*!
+ * Passes if bases of multiprecision data types are cached, and knots of data
+ * types without a std::hash specialization can be hashed.
+ */
+BOOST_AUTO_TEST_CASE(MultiprecisionKnots) {
+        struct Unhashable {};
+        BOOST_TEST(KnotHash<Unhashable>{}(Unhashable{}) == 0);
+        BOOST_TEST(KnotHash<double>{}(1.0) == std::hash<double>{}(1.0));
+
+        using data_t = boost::multiprecision::cpp_bin_float_50;
+        std::vector<data_t> knots(DEFAULT_GRID_DATA.begin(), DEFAULT_GRID_DATA.end());
+        std::vector<data_t> otherKnots(knots);
+        otherKnots.back() += 1;
+
+        BasisCache cache(1 << 20);
+        const auto basis = cache.getBasis<3>(knots);
+        BOOST_TEST((cache.getBasis<3>(knots) == basis));
+        BOOST_TEST((cache.getBasis<3>(otherKnots) != basis));
+        BOOST_TEST(cache.hits() == 1);
+        BOOST_TEST(cache.misses() == 2);
+}
+
+/*!
+ * Passes if invalid knots vectors are rejected without being cached.
+ */
+BOOST_AUTO_TEST_CASE(CacheThrows) {
+        using bspline::exceptions::BSplineException;
+        BasisCache cache(1 << 20);
+        BOOST_REQUIRE_THROW(cache.getBasis<3>(std::vector<double>({0.0, 1.0})), BSplineException);
+        BOOST_TEST(cache.size() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,149 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#include <bspline/BSplineGenerator.h>
+#include <bspline/CollocationMatrix.h>
+#include <bspline/ParallelEvaluator.h>
+#include <bspline/testData.h>
+
+#include <boost/test/tools/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace bspline;
+
+/*!
+ * Checks that the collocation matrix holds exactly the nonzero values of the
+ * splines at the points, with ascending column indices within each row.
+ *
+ * @param matrix The collocation matrix.
+ * @param splines The splines.
+ * @param xs The points.
+ */
+template<typename T, size_t order>
+static void testCollocationMatrix(const CollocationMatrix<T> &matrix,
+                                  const std::vector<Spline<T, order>> &splines,
+                                  const std::vector<T> &xs) {
+    BOOST_REQUIRE(matrix.rows == xs.size());
+    BOOST_REQUIRE(matrix.cols == splines.size());
+    BOOST_REQUIRE(matrix.rowOffsets.size() == xs.size() + 1);
+    std::vector<T> values;
+    std::vector<T> expected;
+    size_t nonZeros = 0;
+    for (size_t i = 0; i < xs.size(); i++) {
+        BOOST_TEST(std::is_sorted(matrix.columnIndices.begin() + matrix.rowOffsets[i],
+                                  matrix.columnIndices.begin() + matrix.rowOffsets[i + 1]));
+        for (size_t j = 0; j < splines.size(); j++) {
+            values.push_back(matrix.at(i, j));
+            expected.push_back(splines[j](xs[i]));
+            nonZeros += (expected.back() != static_cast<T>(0));
+        }
+    }
+    BOOST_TEST(values == expected, boost::test_tools::per_element());
+    BOOST_TEST(matrix.nonZeros() == nonZeros);
+}
+
+BOOST_AUTO_TEST_SUITE(CollocationMatrixTestSuite)
+
+/*!
+ * Passes if the serial and parallel collocation matrices of B-splines hold the
+ * values of the splines, for continuous splines and splines with discontinuities
+ * at the grid points.
+ */
+BOOST_AUTO_TEST_CASE(BSplineCollocation) {
+        const std::vector<double> xs = testPoints(0.001);
+        const std::vector<double> jumping = jumpingOrder(xs);
+
+        const std::vector<double> knots = clampedKnots(3, false);
+        const auto splines = generateBSplines<3>(knots);
+        const auto discontinuous = generateBSplines<0>(DEFAULT_GRID_DATA);
+
+        ParallelEvaluator evaluator(4);
+        for (const auto &points: {xs, jumping}) {
+                testCollocationMatrix(collocationMatrix(splines, points), splines, points);
+                testCollocationMatrix(collocationMatrix(splines, points, evaluator), splines, points);
+                testCollocationMatrix(collocationMatrix(discontinuous, points, evaluator), discontinuous,
+                                      points);
+        }
+
+        // At most order + 1 nonzeros per row for points between the grid points.
+        std::vector<double> midpoints;
+        for (size_t i = 0; i + 1 < DEFAULT_GRID_DATA.size(); i++) {
+                midpoints.push_back((DEFAULT_GRID_DATA[i] + DEFAULT_GRID_DATA[i + 1]) / 2.0);
+        }
+        const auto matrix = collocationMatrix(splines, midpoints);
+        for (size_t i = 0; i < matrix.rows; i++) {
+                BOOST_TEST(matrix.rowOffsets[i + 1] - matrix.rowOffsets[i] <= 4u);
+        }
+}
+
+/*!
+ * Passes if the construction throws for an empty collection of splines or for
+ * splines defined on different grids.
+ */
+BOOST_AUTO_TEST_CASE(CollocationThrows) {
+        using BSplineException = bspline::exceptions::BSplineException;
+
+        const std::vector<Spline<double, 3>> empty;
+        BOOST_REQUIRE_THROW(collocationMatrix(empty, DEFAULT_GRID_DATA), BSplineException);
+
+        std::vector<Spline<double, 3>> differentGrids = generateBSplines<3>(DEFAULT_GRID_DATA);
+        std::vector<double> otherKnots(DEFAULT_GRID_DATA);
+        otherKnots.back() += 1.0;
+        differentGrids.push_back(generateBSplines<3>(otherKnots).front());
+        BOOST_REQUIRE_THROW(collocationMatrix(differentGrids, DEFAULT_GRID_DATA), BSplineException);
+}
+
+/*!
+ * Passes if the least-squares fit reproduces a spline from its values and
+ * interpolates as many values as there are splines.
+ */
+BOOST_AUTO_TEST_CASE(LeastSquaresFit) {
+        const std::vector<double> knots = clampedKnots(3, true);
+        const auto splines = generateBSplines<3>(knots);
+
+        std::vector<double> coefficients;
+        for (size_t j = 0; j < splines.size(); j++) {
+                coefficients.push_back(std::sin(0.3 * static_cast<double>(j)) + 0.1 * static_cast<double>(j));
+        }
+        const auto expected = linearCombination(coefficients, splines);
+
+        std::vector<double> xs;
+        for (double x = -7.0; x <= 7.0; x += 0.01) {
+                xs.push_back(x);
+        }
+        const auto fitted = leastSquaresFit(splines, xs, expected.evaluate(xs));
+        for (const double x: xs) {
+                BOOST_CHECK_SMALL(fitted(x) - expected(x), 1.0e-10);
+        }
+
+        // The Greville abscissae as interpolation points.
+        std::vector<double> greville;
+        for (size_t j = 0; j < splines.size(); j++) {
+                greville.push_back((knots[j + 1] + knots[j + 2] + knots[j + 3]) / 3.0);
+        }
+        std::vector<double> ys;
+        for (const double x: greville) {
+                ys.push_back(std::exp(-x * x / 10.0));
+        }
+        const auto interpolating = leastSquaresFit(splines, greville, ys);
+        for (size_t i = 0; i < greville.size(); i++) {
+                BOOST_CHECK_SMALL(interpolating(greville[i]) - ys[i], 1.0e-10);
+        }
+
+        using BSplineException = bspline::exceptions::BSplineException;
+        BOOST_REQUIRE_THROW(leastSquaresFit(splines, greville, std::vector<double>(3, 1.0)),
+                            BSplineException);
+        // Fewer points than splines.
+        BOOST_REQUIRE_THROW(leastSquaresFit(splines, std::vector<double>{0.0, 1.0},
+                                            std::vector<double>{0.0, 1.0}),
+                            BSplineException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
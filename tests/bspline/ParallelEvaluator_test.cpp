@@ -0,0 +1,154 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#include <bspline/BSplineGenerator.h>
+#include <bspline/ParallelEvaluator.h>
+#include <bspline/testData.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+using namespace bspline;
+
+/*!
+ * Tabulates the splines at the points xs in parallel and compares the values to
+ * those of Spline::evaluate().
+ *
+ * @param evaluator The evaluator to use.
+ * @param splines The splines to evaluate.
+ * @param xs The points.
+ */
+template<typename T, size_t order>
+static void testTabulation(ParallelEvaluator &evaluator, const std::vector<Spline<T, order>> &splines,
+                           const std::vector<T> &xs) {
+    const std::vector<T> values = evaluator.tabulate(splines, xs);
+    BOOST_REQUIRE(values.size() == splines.size() * xs.size());
+    for (size_t k = 0; k < splines.size(); k++) {
+        const std::vector<T> expected = splines[k].evaluate(xs);
+        const std::vector<T> row(values.begin() + k * xs.size(), values.begin() + (k + 1) * xs.size());
+        BOOST_TEST(row == expected, boost::test_tools::per_element());
+        BOOST_TEST(evaluator.evaluate(splines[k], xs) == expected, boost::test_tools::per_element());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(ParallelEvaluatorTestSuite)
+
+/*!
+ * Passes if the parallel evaluation returns the same values as
+ * Spline::evaluate() for sorted and unsorted points, including points outside
+ * of the grid, for several numbers of threads.
+ */
+BOOST_AUTO_TEST_CASE(EvaluateSplines) {
+        const std::vector<double> knots = clampedKnots(3, false);
+        const auto splines = generateBSplines<3>(knots);
+
+        const std::vector<double> sorted = testPoints(0.0005);
+        const std::vector<double> jumping = jumpingOrder(sorted);
+
+        for (size_t nThreads: {1, 4}) {
+                ParallelEvaluator evaluator(nThreads);
+                BOOST_TEST(evaluator.getThreadCount() == nThreads);
+                testTabulation(evaluator, splines, sorted);
+                testTabulation(evaluator, splines, jumping);
+                testTabulation(evaluator, splines, DEFAULT_GRID_DATA);
+        }
+}
+
+/*!
+ * Passes if the evaluator handles empty collections of splines and points.
+ */
+BOOST_AUTO_TEST_CASE(EmptyInput) {
+        ParallelEvaluator evaluator(3);
+        const auto splines = generateBSplines<2>(DEFAULT_GRID_DATA);
+        const std::vector<double> noPoints;
+        const std::vector<Spline<double, 2>> noSplines;
+
+        BOOST_TEST(evaluator.tabulate(splines, noPoints).empty());
+        BOOST_TEST(evaluator.tabulate(noSplines, DEFAULT_GRID_DATA).empty());
+        BOOST_TEST(evaluator.evaluate(Spline<double, 2>{splines.front().getSupport().getGrid()},
+                                      DEFAULT_GRID_DATA) ==
+                   std::vector<double>(DEFAULT_GRID_DATA.size(), 0.0));
+}
+
+/*!
+ * Passes if the BSplines generated in parallel coincide with those generated
+ * serially, for any number of threads and chunks and any order of execution.
+ */
+BOOST_AUTO_TEST_CASE(ParallelGeneration) {
+        std::vector<double> knots(4, -1.0);
+        for (size_t i = 0; i < 1400; i++) {
+                knots.push_back(-1.0 + 8.0e-4 * static_cast<double>(i * i % 1009) / 1009.0 +
+                                8.0e-4 * static_cast<double>(i));
+        }
+        std::sort(knots.begin(), knots.end());
+        knots.insert(knots.end(), 3, knots.back());
+
+        const BSplineGenerator generator(knots);
+        const auto expected = generator.generateBSplines<5>();
+
+        for (size_t nThreads: {1, 4}) {
+                ParallelEvaluator evaluator(nThreads);
+                BOOST_TEST((generator.generateBSplines<5>(evaluator) == expected));
+        }
+
+        // Chunks executed in reverse order.
+        const auto reversed = generator.generateBSplines<5>(
+                37, [](size_t nTasks, const std::function<void(size_t)> &task) {
+                        for (size_t c = nTasks; c > 0; c--) task(c - 1);
+                });
+        BOOST_TEST((reversed == expected));
+
+        ParallelEvaluator evaluator(3);
+        BOOST_REQUIRE_THROW(BSplineGenerator(std::vector<double>{0.0, 1.0}).generateBSplines<5>(evaluator),
+                            bspline::exceptions::BSplineException);
+}
+
+/*!
+ * Passes if an exception thrown by a task of the thread pool is rethrown to the
+ * caller after all other tasks have finished.
+ */
+BOOST_AUTO_TEST_CASE(ThreadPoolRethrows) {
+        internal::ThreadPool pool(4);
+        std::vector<int> done(100, 0);
+        BOOST_REQUIRE_THROW(pool.parallelFor(done.size(), [&](size_t i) {
+                                    if (i == 17) throw std::runtime_error("task failed");
+                                    done[i] = 1;
+                            }),
+                            std::runtime_error);
+        BOOST_TEST(std::count(done.begin(), done.end(), 1) == 99);
+
+        pool.parallelFor(done.size(), [&](size_t i) { done[i] = 2; });
+        BOOST_TEST(std::count(done.begin(), done.end(), 2) == 100);
+}
+
+/*!
+ * Passes if tasks calling parallelFor() of the pool executing them do not
+ * deadlock, but execute the nested tasks inline.
+ */
+BOOST_AUTO_TEST_CASE(ThreadPoolReentrant) {
+        internal::ThreadPool pool(4);
+        std::vector<int> done(20 * 30, 0);
+        pool.parallelFor(20, [&](size_t i) {
+                pool.parallelFor(30, [&](size_t j) { done[30 * i + j]++; });
+        });
+        BOOST_TEST(std::count(done.begin(), done.end(), 1) == 600);
+
+        // Assemblies on the threads of an evaluator, started from its own tasks.
+        ParallelEvaluator evaluator(3);
+        const BSplineGenerator generator(DEFAULT_GRID_DATA);
+        const auto expected = generator.generateBSplines<3>();
+        std::vector<char> identical(4, 0);
+        evaluator.parallelFor(identical.size(), [&](size_t i) {
+                identical[i] = generator.generateBSplines<3>(evaluator) == expected;
+        });
+        BOOST_TEST((identical == std::vector<char>(4, 1)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,80 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#include <bspline/BSplineGenerator.h>
+#include <bspline/SoASpline.h>
+#include <bspline/integration/LinearForm.h>
+#include <bspline/testData.h>
+
+#include <boost/test/tools/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <cstdint>
+
+using namespace bspline;
+
+/*!
+ * Checks that the structure-of-arrays representation of each spline evaluates
+ * and integrates to the same values as the spline and converts back to the
+ * same spline.
+ *
+ * @param splines The splines to check.
+ * @param xs The points at which the splines are evaluated.
+ */
+template<typename T, size_t order>
+static void testSoASplines(const std::vector<Spline<T, order>> &splines, const std::vector<T> &xs) {
+    const integration::LinearForm integral;
+    for (const auto &spline: splines) {
+        const SoASpline soa(spline);
+        BOOST_TEST((soa.toSpline() == spline));
+        BOOST_TEST(soa.evaluate(xs) == spline.evaluate(xs), boost::test_tools::per_element());
+        for (const T &x: DEFAULT_GRID_DATA) {
+            BOOST_TEST(soa(x) == spline(x));
+        }
+        const T expected = integral.evaluate(spline);
+        BOOST_CHECK_SMALL(soa.integrate() - expected, static_cast<T>(1.0e-14) * std::abs(expected));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(SoASplineTestSuite)
+
+/*!
+ * Passes if the structure-of-arrays representation reproduces the values and
+ * integrals of splines of several orders for sorted and unsorted points,
+ * including points outside of the grid.
+ */
+BOOST_AUTO_TEST_CASE(EvaluateAndIntegrate) {
+        const std::vector<double> sorted = testPoints(0.01);
+        const std::vector<double> jumping = jumpingOrder(sorted);
+
+        testSoASplines(generateBSplines<0>(DEFAULT_GRID_DATA), sorted);
+        testSoASplines(generateBSplines<3>(DEFAULT_GRID_DATA), sorted);
+        testSoASplines(generateBSplines<3>(DEFAULT_GRID_DATA), jumping);
+        testSoASplines(generateBSplines<8>(DEFAULT_GRID_DATA), jumping);
+}
+
+/*!
+ * Passes if the coefficient arrays are aligned and the representation of an
+ * empty spline evaluates and integrates to zero.
+ */
+BOOST_AUTO_TEST_CASE(AlignmentAndEmptySpline) {
+        const auto splines = generateBSplines<4>(DEFAULT_GRID_DATA);
+        const SoASpline soa(splines[3]);
+        for (size_t p = 0; p <= 4; p++) {
+                BOOST_TEST(reinterpret_cast<std::uintptr_t>(soa.getCoefficients(p)) %
+                           internal::SIMD_ALIGNMENT == 0);
+        }
+
+        const SoASpline empty(Spline<double, 4>(splines[3].getSupport().getGrid()));
+        BOOST_TEST(empty.integrate() == 0.0);
+        BOOST_TEST(empty.evaluate(DEFAULT_GRID_DATA) ==
+                   std::vector<double>(DEFAULT_GRID_DATA.size(), 0.0));
+        BOOST_TEST((empty.toSpline() == Spline<double, 4>(splines[3].getSupport().getGrid())));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
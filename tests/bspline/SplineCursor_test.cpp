@@ -0,0 +1,84 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#include <bspline/BSplineGenerator.h>
+#include <bspline/SplineCursor.h>
+#include <bspline/testData.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace bspline;
+
+/*!
+ * Evaluates all splines with a cursor at the points xs and compares the values
+ * to those of Spline::operator().
+ *
+ * @param splines The splines to evaluate.
+ * @param xs The points.
+ */
+template<typename T, size_t order>
+static void testCursor(const std::vector<Spline<T, order>> &splines, const std::vector<T> &xs) {
+    SplineCursor cursor(splines);
+    BOOST_TEST(cursor.size() == splines.size());
+    for (const T &x: xs) {
+        const std::vector<T> values = cursor.evaluate(x);
+        for (size_t i = 0; i < splines.size(); i++) {
+            BOOST_TEST(values[i] == splines[i](x));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(SplineCursorTestSuite)
+
+/*!
+ * Passes if the cursor returns the same values as Spline::operator() for
+ * increasing, decreasing and random points, including the grid points and
+ * points outside of the grid.
+ */
+BOOST_AUTO_TEST_CASE(EvaluateSplines) {
+        const std::vector<double> knots = clampedKnots(3, false);
+        const auto splines = generateBSplines<3>(knots);
+
+        const std::vector<double> increasing = testPoints(0.01);
+        testCursor(splines, increasing);
+        testCursor(splines, std::vector<double>(increasing.rbegin(), increasing.rend()));
+        testCursor(splines, jumpingOrder(increasing));
+}
+
+/*!
+ * Passes if the cursor for a single spline returns the same values as
+ * Spline::operator().
+ */
+BOOST_AUTO_TEST_CASE(EvaluateSingleSpline) {
+        const auto splines = generateBSplines<0>(DEFAULT_GRID_DATA);
+        for (const auto &spline: splines) {
+                SplineCursor cursor(spline);
+                for (double x: DEFAULT_GRID_DATA) {
+                        BOOST_TEST(cursor(x) == spline(x));
+                }
+        }
+}
+
+/*!
+ * Passes if the construction of a cursor throws for an empty collection of
+ * splines or for splines defined on different grids.
+ */
+BOOST_AUTO_TEST_CASE(ConstructionThrows) {
+        using BSplineException = bspline::exceptions::BSplineException;
+
+        const std::vector<Spline<double, 3>> empty;
+        BOOST_REQUIRE_THROW(SplineCursor{empty}, BSplineException);
+
+        std::vector<Spline<double, 3>> differentGrids =
+                generateBSplines<3>(DEFAULT_GRID_DATA);
+        std::vector<double> otherKnots(DEFAULT_GRID_DATA);
+        otherKnots.back() += 1.0;
+        differentGrids.push_back(generateBSplines<3>(otherKnots).front());
+        BOOST_REQUIRE_THROW(SplineCursor{differentGrids}, BSplineException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#include <bspline/BSplineGenerator.h>
+#include <bspline/SplineView.h>
+#include <bspline/integration/BilinearForm.h>
+#include <bspline/integration/LinearForm.h>
+#include <bspline/operators/Derivative.h>
+#include <bspline/operators/Position.h>
+#include <bspline/testData.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace bspline;
+using namespace bspline::operators;
+
+/*!
+ * Checks that views of coefficients copied into one contiguous buffer evaluate,
+ * integrate and transform to the same values as the splines.
+ *
+ * @param splines The splines to check.
+ * @param xs The points at which the splines are evaluated.
+ */
+template<typename T, size_t order>
+static void testViews(const std::vector<Spline<T, order>> &splines, const std::vector<T> &xs) {
+    // The coefficients of all splines in one buffer.
+    std::vector<std::array<T, order + 1>> buffer;
+    std::vector<size_t> offsets;
+    for (const auto &s: splines) {
+        offsets.push_back(buffer.size());
+        buffer.insert(buffer.end(), s.getCoefficients().begin(), s.getCoefficients().end());
+    }
+
+    const integration::LinearForm integral;
+    const integration::ScalarProduct scalarProduct;
+    const integration::BilinearForm kinetic{Dx<2>{}};
+
+    for (size_t i = 0; i < splines.size(); i++) {
+        const auto &s = splines[i];
+        const SplineView view(s.getSupport(), buffer.data() + offsets[i]);
+        const auto &neighbour = splines[(i + 1) % splines.size()];
+        const SplineView neighbourView(neighbour);
+
+        BOOST_TEST(view.getCoefficients() == buffer.data() + offsets[i]);
+        BOOST_TEST((view.toSpline() == s));
+        BOOST_TEST(view.evaluate(xs) == s.evaluate(xs), boost::test_tools::per_element());
+        BOOST_TEST(integral.evaluate(view) == integral.evaluate(s));
+        BOOST_TEST(scalarProduct.evaluate(view, neighbourView) == scalarProduct.evaluate(s, neighbour));
+        BOOST_TEST(kinetic.evaluate(view, neighbour) == kinetic.evaluate(s, neighbour));
+        BOOST_TEST(kinetic.evaluate(neighbour, view) == kinetic.evaluate(neighbour, s));
+        BOOST_TEST((Dx<1>{} * view == Dx<1>{} * s));
+        BOOST_TEST((X<1>{} * view == X<1>{} * s));
+        for (const T &x: xs) {
+            BOOST_TEST(view(x) == s(x));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(SplineViewTestSuite)
+
+/*!
+ * Passes if views of splines, whose coefficients are stored in one external
+ * buffer, behave as the splines.
+ */
+BOOST_AUTO_TEST_CASE(ViewsMatchSplines) {
+        const std::vector<double> xs = testPoints(0.01);
+        const std::vector<double> reversed(xs.rbegin(), xs.rend());
+
+        testViews(generateBSplines<0>(DEFAULT_GRID_DATA), xs);
+        testViews(generateBSplines<3>(DEFAULT_GRID_DATA), xs);
+        testViews(generateBSplines<3>(DEFAULT_GRID_DATA), reversed);
+        testViews(generateBSplines<7>(DEFAULT_GRID_DATA), xs);
+}
+
+/*!
+ * Passes if a view of an empty spline evaluates to zero and views without
+ * coefficients or with index ranges outside of the grid are rejected.
+ */
+BOOST_AUTO_TEST_CASE(EmptyAndInvalidViews) {
+        const auto splines = generateBSplines<2>(DEFAULT_GRID_DATA);
+        const Spline<double, 2> empty(splines[0].getSupport().getGrid());
+        const SplineView emptyView(empty);
+        BOOST_TEST(emptyView.evaluate(DEFAULT_GRID_DATA) ==
+                   std::vector<double>(DEFAULT_GRID_DATA.size(), 0.0));
+        BOOST_TEST(integration::LinearForm{}.evaluate(emptyView) == 0.0);
+
+        const std::array<double, 3> *noCoefficients = nullptr;
+        BOOST_REQUIRE_THROW(SplineView(splines[0].getSupport(), noCoefficients),
+                            bspline::exceptions::BSplineException);
+
+        const auto &grid = splines[0].getSupport().getGrid();
+        const auto *coefficients = splines[0].getCoefficients().data();
+        BOOST_REQUIRE_THROW(SplineView(grid, 3, 2, coefficients), bspline::exceptions::BSplineException);
+        BOOST_REQUIRE_THROW(SplineView(grid, 0, grid.size() + 1, coefficients),
+                            bspline::exceptions::BSplineException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -9,9 +9,12 @@
 #include <bspline/Core.h>
 #include <bspline/integration/analytical.h>
 #include <bspline/integration/numerical.h>
+#include <bspline/testData.h>
 
 #include <boost/test/tools/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <memory_resource>
 #include <type_traits>
 
 using bspline::BSplineGenerator;
@@ -39,11 +42,7 @@ void testIntegration(T tol) {
 
     using Spline = bspline::Spline<T, order>;
     using Spline0 = bspline::Spline<T, 0>;
-    const BSplineGenerator generator(std::vector<T>{
-            -7.0l, -6.85l, -6.55l, -6.3l, -6.0l, -5.75l, -5.53l, -5.2l,
-            -4.75l, -4.5l, -3.0l, -2.5l, -1.5l, -1.0l, 0.0l, 0.5l,
-            1.5l, 2.5l, 3.5l, 4.0l, 4.35l, 4.55l, 4.95l, 5.4l,
-            5.7l, 6.1l, 6.35l, 6.5l, 6.85l, 7.0l});
+    const BSplineGenerator generator(defaultKnots<T>());
 
     const std::vector<Spline> splines =
             generator.template generateBSplines<order>();
@@ -104,11 +103,7 @@ void testArithmetic(T tol) {
     using Spline6 = bspline::Spline<T, 2 * order>;
     using Spline0 = bspline::Spline<T, 0>;
 
-    BSplineGenerator<T> generator(std::vector<T>{
-            -7.0l, -6.85l, -6.55l, -6.3l, -6.0l, -5.75l, -5.53l, -5.2l,
-            -4.75l, -4.5l, -3.0l, -2.5l, -1.5l, -1.0l, 0.0l, 0.5l,
-            1.5l, 2.5l, 3.5l, 4.0l, 4.35l, 4.55l, 4.95l, 5.4l,
-            5.7l, 6.1l, 6.35l, 6.5l, 6.85l, 7.0l});
+    BSplineGenerator<T> generator(defaultKnots<T>());
 
     const std::vector<Spline> splines =
             generator.template generateBSplines<order>();
@@ -172,6 +167,270 @@ void testArithmetic(T tol) {
     BOOST_TEST(static_cast<T>(1) == one(one.back()));
 }
 
+template<typename T, size_t order>
+void testBatchedEvaluation(const std::vector<T> &knots) {
+    BSplineGenerator<T> generator(knots);
+
+    const auto splines = generator.template generateBSplines<order>();
+
+    // Sorted points, including all grid points and points outside the grid.
+    std::vector<T> sorted(generator.getGrid().begin(),
+                          generator.getGrid().end());
+    for (T x = static_cast<T>(-8); x <= static_cast<T>(8); x += 0.03L) {
+        sorted.push_back(x);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    // The same points in descending order.
+    const std::vector<T> unsorted(sorted.rbegin(), sorted.rend());
+
+    for (const auto &s: splines) {
+        for (const std::vector<T> &xs: {sorted, unsorted}) {
+            std::vector<T> expected;
+            for (const T &x: xs) {
+                expected.push_back(s(x));
+            }
+            BOOST_TEST(s.evaluate(xs) == expected, boost::test_tools::per_element());
+        }
+    }
+}
+
+template<typename T, size_t order>
+void testBatchedEvaluation() {
+    // Non-uniform grid.
+    testBatchedEvaluation<T, order>(defaultKnots<T>());
+
+    // Uniform grid.
+    std::vector<T> uniformKnots;
+    for (int i = -70; i <= 70; i++) {
+        uniformKnots.push_back(static_cast<T>(i) / 10);
+    }
+    testBatchedEvaluation<T, order>(uniformKnots);
+}
+
+template<typename T, size_t order>
+void testDerivativeEvaluation(T tol) {
+    using namespace bspline::operators;
+    constexpr size_t M = 3;
+
+    BSplineGenerator<T> generator(defaultKnots<T>());
+    const auto splines = generator.template generateBSplines<order>();
+
+    std::vector<T> xs(generator.getGrid().begin(), generator.getGrid().end());
+    for (T x = static_cast<T>(-8); x <= static_cast<T>(8); x += 0.07L) {
+        xs.push_back(x);
+    }
+    std::sort(xs.begin(), xs.end());
+    const std::vector<T> reversed(xs.rbegin(), xs.rend());
+
+    for (const auto &s: splines) {
+        const auto d1 = Dx<1>{} * s;
+        const auto d2 = Dx<2>{} * s;
+        const auto d3 = Dx<3>{} * s;
+        const auto sorted = s.template evaluateDerivatives<M>(xs);
+        const auto unsorted = s.template evaluateDerivatives<M>(reversed);
+        BOOST_REQUIRE(sorted.size() == xs.size());
+
+        for (size_t i = 0; i < xs.size(); i++) {
+            const T x = xs[i];
+            const auto single = s.template evaluateDerivatives<M>(x);
+            BOOST_TEST(single[0] == s(x));
+            // The derivatives are compared relative to their magnitude.
+            BOOST_CHECK_SMALL(single[1] - d1(x), tol * (1 + std::abs(d1(x))));
+            BOOST_CHECK_SMALL(single[2] - d2(x), tol * (1 + std::abs(d2(x))));
+            BOOST_CHECK_SMALL(single[3] - d3(x), tol * (1 + std::abs(d3(x))));
+            BOOST_TEST((sorted[i] == single));
+            BOOST_TEST((unsorted[xs.size() - 1 - i] == single));
+        }
+    }
+}
+
+template<typename T, size_t order>
+void testTemporaryArithmetic() {
+    BSplineGenerator<T> generator(defaultKnots<T>());
+    const auto splines = generator.template generateBSplines<order>();
+    const auto lowerSplines = generator.template generateBSplines<order - 1>();
+    const T d = static_cast<T>(0.7l);
+
+    // Temporaries, which may be modified in-place, yield the same results as
+    // const operands, for overlapping, contained and disjoint supports.
+    for (size_t i = 0; i < splines.size(); i += 3) {
+        const auto &a = splines[i];
+        for (size_t j = 0; j < splines.size(); j += 2) {
+            const auto &b = splines[j];
+            const auto &c = lowerSplines[j];
+            auto sum = a;
+            sum += b;
+            auto difference = a;
+            difference -= c;
+            BOOST_TEST((Spline(a) + b == a + b));
+            BOOST_TEST((Spline(a) - b == a - b));
+            BOOST_TEST((Spline(a) + c == a + c));
+            BOOST_TEST((Spline(a) - c == a - c));
+            BOOST_TEST((Spline(c) + a == c + a));
+            BOOST_TEST((sum == a + b));
+            BOOST_TEST((difference == a - c));
+            BOOST_TEST((a - b == a + static_cast<T>(-1) * b));
+        }
+        BOOST_TEST((Spline(a) * d == a * d));
+        BOOST_TEST((d * Spline(a) == d * a));
+        BOOST_TEST((Spline(a) / d == a / d));
+        BOOST_TEST((-Spline(a) == -a));
+    }
+
+    // Summing up splines within the support of a temporary reuses its storage.
+    Spline<T, order> total = splines.front();
+    for (const auto &s: splines) total += s;
+    const auto *data = total.getCoefficients().data();
+    const auto result = (std::move(total) + splines[3] - splines[5]) * d;
+    BOOST_TEST(result.getCoefficients().data() == data);
+
+    // A temporary, whose support grows, is reallocated. In a chain starting from
+    // a named spline, the growth happens in the in-place step of the temporary
+    // a + b. The supports of the first and the last spline are disjoint.
+    const auto &far = splines[3 + order + 2];
+    Spline<T, order> grown = splines[3];
+    const auto *grownData = grown.getCoefficients().data();
+    grown = std::move(grown) + far;
+    BOOST_TEST(grown.getCoefficients().data() != grownData);
+    BOOST_TEST((grown == splines[3] + far));
+    BOOST_TEST((grown.getSupport() == splines[3].getSupport().calcUnion(far.getSupport())));
+    BOOST_TEST((splines[3] + splines[4] + far == splines[3] + (splines[4] + far)));
+    BOOST_TEST((splines[3] - splines[4] - far == splines[3] - (splines[4] + far)));
+
+    // Splines on differing grids can not be added.
+    const Spline<T, order> other(Grid<T>(std::vector<T>{-1.0l, 0.0l, 1.0l}));
+    BOOST_REQUIRE_THROW(Spline(splines[0]) + other, BSplineException);
+    Spline<T, order> copy = splines[0];
+    BOOST_REQUIRE_THROW(copy += other, BSplineException);
+}
+
+template<typename T, size_t order>
+void testInPlaceAccumulation() {
+    BSplineGenerator<T> generator(defaultKnots<T>());
+    const auto splines = generator.template generateBSplines<order>();
+    const auto lowerSplines = generator.template generateBSplines<order - 1>();
+
+    // Accumulating from the middle outwards grows the support at both ends.
+    Spline<T, order> accumulated(generator.getGrid());
+    Spline<T, order> expected(generator.getGrid());
+    const size_t middle = splines.size() / 2;
+    for (size_t k = 0; k < splines.size(); k++) {
+        const size_t i = (k % 2 == 0) ? middle + k / 2 : middle - (k + 1) / 2;
+        const T factor = static_cast<T>(k + 1) / 3;
+        accumulated += factor * splines[i];
+        accumulated -= lowerSplines[i];
+        expected = expected + factor * splines[i];
+        expected = expected - lowerSplines[i];
+    }
+    BOOST_TEST((accumulated == expected));
+    BOOST_TEST((accumulated.getSupport() == Support<T>::createWholeGrid(generator.getGrid())));
+
+    // Accumulation within the support does not reallocate.
+    const auto *data = accumulated.getCoefficients().data();
+    for (const auto &s: splines) accumulated -= s;
+    BOOST_TEST(accumulated.getCoefficients().data() == data);
+}
+
+template<typename T, size_t order>
+void testMemoryResource() {
+    const std::vector<T> knots = defaultKnots<T>();
+    const auto expected = generateBSplines<order>(knots);
+
+    std::pmr::monotonic_buffer_resource arena;
+    CountingResource arenaCounter(&arena);
+    CountingResource defaultCounter(std::pmr::new_delete_resource());
+    std::pmr::memory_resource *previousDefault =
+            std::pmr::set_default_resource(&defaultCounter);
+
+    {
+        // The basis and all intermediate coefficients are allocated from the arena.
+        const auto basis = generateBasis<order>(knots, &arenaCounter);
+        BOOST_TEST(defaultCounter.allocations == 0);
+        BOOST_TEST(arenaCounter.allocations > 0);
+        BOOST_TEST(basis.getCoefficients().get_allocator().resource() == &arenaCounter);
+        BOOST_TEST((basis.toSplines() == expected));
+
+        // Moving the basis keeps the arena.
+        BSplineBasis<T, order> moved = generateBasis<order>(knots, &arenaCounter);
+        const size_t arenaAllocations = arenaCounter.allocations;
+        const BSplineBasis<T, order> target(std::move(moved));
+        BOOST_TEST(arenaCounter.allocations == arenaAllocations);
+        BOOST_TEST(defaultCounter.allocations == 0);
+        BOOST_TEST(target.getCoefficients().get_allocator().resource() == &arenaCounter);
+
+        // Copies of the basis use the default resource.
+        const BSplineBasis<T, order> copy = basis;
+        BOOST_TEST(copy.getCoefficients().get_allocator().resource() == &defaultCounter);
+        BOOST_TEST((copy.toSplines() == expected));
+    }
+
+    // Splines are not tied to a memory resource.
+    static_assert(std::is_same_v<typename Spline<T, order>::coefficients_type,
+                                 std::vector<std::array<T, order + 1>>>);
+    BOOST_TEST((generateBasis<order>(knots).toSplines() == expected));
+
+    std::pmr::set_default_resource(previousDefault);
+}
+
+/*!
+ * Generates BSplines by applying the operators of the recursion relation to
+ * the lower order splines.
+ *
+ * @param knots The knots vector.
+ * @param grid The grid generated from the knots vector.
+ * @returns All BSplines of order order defined on the knots vector.
+ */
+template<typename T, size_t order>
+std::vector<Spline<T, order>> generateBSplinesRecursively(const std::vector<T> &knots,
+                                                          const Grid<T> &grid) {
+    using namespace bspline::operators;
+    std::vector<Spline<T, order>> ret;
+    if constexpr (order == 0) {
+        for (size_t i = 0; i + 1 < knots.size(); i++) {
+            if (knots[i] == knots[i + 1]) {
+                ret.push_back(Spline<T, 0>(grid));
+            } else {
+                const size_t gridIndex = grid.findElement(knots[i]);
+                ret.push_back(Spline<T, 0>(Support<T>(grid, gridIndex, gridIndex + 2),
+                                           {{static_cast<T>(1)}}));
+            }
+        }
+    } else {
+        constexpr size_t k = order + 1;
+        const auto lower = generateBSplinesRecursively<T, order - 1>(knots, grid);
+        for (size_t i = 0; i + k < knots.size(); i++) {
+            Spline<T, order> s(grid);
+            if (knots[i + k - 1] > knots[i]) {
+                const T prefac = static_cast<T>(1) / (knots[i + k - 1] - knots[i]);
+                s = (prefac * (X<1>{} - knots[i])) * lower[i];
+            }
+            if (knots[i + k] > knots[i + 1]) {
+                const T prefac = static_cast<T>(1) / (knots[i + k] - knots[i + 1]);
+                s += (prefac * (knots[i + k] - X<1>{})) * lower[i + 1];
+            }
+            ret.push_back(std::move(s));
+        }
+    }
+    return ret;
+}
+
+template<typename T, size_t order>
+void testDirectGeneration() {
+    const std::vector<std::vector<T>> knotsVectors{
+            defaultKnots<T>(),
+            // Repeated knots reduce the continuity and lead to empty lower order splines.
+            {0.0l, 0.0l, 0.0l, 0.0l, 0.0l, 0.3l, 1.0l, 1.0l, 2.0l, 2.5l, 2.5l, 2.5l, 3.1l,
+             4.0l, 4.7l, 5.0l, 5.0l, 5.0l, 5.0l, 5.0l, 5.0l, 5.0l, 5.0l, 5.0l, 5.0l, 5.0l}};
+
+    for (const auto &knots: knotsVectors) {
+        const BSplineGenerator<T> generator(knots);
+        const auto splines = generator.template generateBSplines<order>();
+        const auto expected = generateBSplinesRecursively<T, order>(knots, generator.getGrid());
+        BOOST_TEST((splines == expected));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE(SplineArithmeticTestSuite)
 BOOST_AUTO_TEST_CASE(TestIntegration) {
         constexpr double TOL = 1.0e-15;
@@ -225,4 +484,69 @@ BOOST_AUTO_TEST_CASE(TestArithmetic) {
         }
 }
 
+BOOST_AUTO_TEST_CASE(TestBatchedEvaluation) {
+        testBatchedEvaluation<double, 0>();
+        testBatchedEvaluation<double, 3>();
+        testBatchedEvaluation<double, 10>();
+        testBatchedEvaluation<float, 3>();
+        testBatchedEvaluation<float, 10>();
+
+        if constexpr (sizeof(long double) != sizeof(double)) {
+            testBatchedEvaluation<long double, 3>();
+            testBatchedEvaluation<long double, 10>();
+        }
+}
+
+BOOST_AUTO_TEST_CASE(TestDerivativeEvaluation) {
+        testDerivativeEvaluation<double, 0>(1.0e-12);
+        testDerivativeEvaluation<double, 1>(1.0e-12);
+        testDerivativeEvaluation<double, 3>(1.0e-12);
+        testDerivativeEvaluation<double, 5>(1.0e-12);
+
+        if constexpr (sizeof(long double) != sizeof(double)) {
+            testDerivativeEvaluation<long double, 3>(1.0e-15l);
+            testDerivativeEvaluation<long double, 5>(1.0e-15l);
+        }
+}
+
+BOOST_AUTO_TEST_CASE(TestTemporaryArithmetic) {
+        testTemporaryArithmetic<double, 1>();
+        testTemporaryArithmetic<double, 3>();
+        testTemporaryArithmetic<double, 6>();
+
+        if constexpr (sizeof(long double) != sizeof(double)) {
+            testTemporaryArithmetic<long double, 3>();
+        }
+}
+
+BOOST_AUTO_TEST_CASE(TestInPlaceAccumulation) {
+        testInPlaceAccumulation<double, 1>();
+        testInPlaceAccumulation<double, 3>();
+        testInPlaceAccumulation<double, 6>();
+
+        if constexpr (sizeof(long double) != sizeof(double)) {
+            testInPlaceAccumulation<long double, 3>();
+        }
+}
+
+BOOST_AUTO_TEST_CASE(TestMemoryResource) {
+        testMemoryResource<double, 0>();
+        testMemoryResource<double, 3>();
+        testMemoryResource<long double, 5>();
+}
+
+BOOST_AUTO_TEST_CASE(TestDirectGeneration) {
+        testDirectGeneration<double, 0>();
+        testDirectGeneration<double, 1>();
+        testDirectGeneration<double, 3>();
+        testDirectGeneration<double, 7>();
+        testDirectGeneration<double, 10>();
+        testDirectGeneration<float, 5>();
+
+        if constexpr (sizeof(long double) != sizeof(double)) {
+            testDirectGeneration<long double, 4>();
+            testDirectGeneration<long double, 10>();
+        }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
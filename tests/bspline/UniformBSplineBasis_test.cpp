@@ -0,0 +1,146 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#include <bspline/BSplineGenerator.h>
+#include <bspline/CollocationMatrix.h>
+#include <bspline/ParallelEvaluator.h>
+#include <bspline/SplineCursor.h>
+#include <bspline/UniformBSplineBasis.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <iterator>
+
+using namespace bspline;
+
+/*!
+ * Generates a uniform knots vector on [-3, 5] with the given multiplicity of
+ * the first and the last knot.
+ *
+ * @param multiplicity The number of times the first and the last knot are
+ * contained.
+ * @returns The knots vector.
+ */
+static std::vector<double> uniformKnots(size_t multiplicity) {
+    std::vector<double> knots(multiplicity - 1, -3.0);
+    for (int i = 0; i <= 32; i++) {
+        knots.push_back(-3.0 + 0.25 * i);
+    }
+    knots.insert(knots.end(), multiplicity - 1, 5.0);
+    return knots;
+}
+
+/*!
+ * Checks that a uniform basis yields the same results as the splines
+ * generated by BSplineGenerator, up to rounding errors, and that it stores a
+ * single set of interior coefficients.
+ *
+ * @param knots The knots vector.
+ * @param xs The points at which the splines are evaluated.
+ */
+template<typename T, size_t order>
+static void testUniformBasis(const std::vector<T> &knots, const std::vector<T> &xs) {
+    static constexpr T TOL = 1e-13;
+    const auto checkClose = [](const std::vector<T> &a, const std::vector<T> &b) {
+        BOOST_REQUIRE(a.size() == b.size());
+        for (size_t i = 0; i < a.size(); i++) {
+            BOOST_CHECK_SMALL(a[i] - b[i], TOL);
+        }
+    };
+
+    const auto splines = generateBSplines<order>(knots);
+    const auto basis = generateUniformBasis<order>(knots);
+
+    BOOST_REQUIRE(basis.size() == splines.size());
+    BOOST_TEST(basis.numberOfTranslates() > 0);
+    BOOST_TEST(basis.getReferenceCoefficients().size() == order + 1);
+    BOOST_TEST((basis.getGrid() == splines.front().getSupport().getGrid()));
+    BOOST_TEST(static_cast<size_t>(std::distance(basis.begin(), basis.end())) == splines.size());
+
+    size_t i = 0;
+    for (auto it = basis.begin(); it != basis.end(); it++, i++) {
+        BOOST_TEST((it->getSupport() == splines[i].getSupport()));
+        checkClose(basis.at(i).evaluate(xs), splines[i].evaluate(xs));
+    }
+
+    ParallelEvaluator evaluator(2);
+    checkClose(evaluator.tabulate(basis, xs), evaluator.tabulate(splines, xs));
+
+    const auto basisMatrix = collocationMatrix(basis, xs);
+    const auto splinesMatrix = collocationMatrix(splines, xs);
+    BOOST_TEST(basisMatrix.rowOffsets == splinesMatrix.rowOffsets, boost::test_tools::per_element());
+    BOOST_TEST(basisMatrix.columnIndices == splinesMatrix.columnIndices, boost::test_tools::per_element());
+    checkClose(basisMatrix.values, splinesMatrix.values);
+
+    SplineCursor basisCursor(basis);
+    SplineCursor splinesCursor(splines);
+    for (const T &x: xs) {
+        checkClose(basisCursor.evaluate(x), splinesCursor.evaluate(x));
+    }
+
+    std::vector<T> coeffs(splines.size());
+    for (size_t j = 0; j < coeffs.size(); j++) {
+        coeffs[j] = static_cast<T>(j % 5) - static_cast<T>(2);
+    }
+    checkClose(linearCombination(coeffs, basis).evaluate(xs), linearCombination(coeffs, splines).evaluate(xs));
+}
+
+BOOST_AUTO_TEST_SUITE(UniformBSplineBasisTestSuite)
+
+/*!
+ * Passes if a uniform basis behaves as the vector of the same splines, for
+ * knots vectors with and without repeated boundary knots.
+ */
+BOOST_AUTO_TEST_CASE(UniformBasisMatchesSplines) {
+        std::vector<double> xs;
+        for (double x = -4.0; x <= 6.0; x += 0.01) {
+                xs.push_back(x);
+        }
+
+        testUniformBasis<double, 0>(uniformKnots(1), xs);
+        testUniformBasis<double, 1>(uniformKnots(2), xs);
+        testUniformBasis<double, 3>(uniformKnots(1), xs);
+        testUniformBasis<double, 3>(uniformKnots(4), xs);
+        testUniformBasis<double, 7>(uniformKnots(8), xs);
+        testUniformBasis<double, 7>(uniformKnots(3), xs);
+}
+
+/*!
+ * Passes if only the boundary splines and a single reference spline are
+ * stored, the translates sharing the reference coefficients.
+ */
+BOOST_AUTO_TEST_CASE(CompactStorage) {
+        const auto basis = generateUniformBasis<3>(uniformKnots(4));
+        BOOST_TEST(basis.size() == 35);
+        BOOST_TEST(basis.numberOfTranslates() == 29);
+        BOOST_TEST(basis.getBoundaryCoefficients().size() == 12);
+
+        for (size_t i = 3; i < 32; i++) {
+                const auto view = basis[i];
+                BOOST_TEST(view.getCoefficients() == basis.getReferenceCoefficients().data());
+                BOOST_TEST(view.getSupport().getStartIndex() == i - 3);
+        }
+}
+
+/*!
+ * Passes if knots vectors which are too short, not sorted, not equally spaced
+ * or contain repeated interior knots as well as accesses out of bounds are
+ * rejected.
+ */
+BOOST_AUTO_TEST_CASE(UniformBasisThrows) {
+        using bspline::exceptions::BSplineException;
+        using Basis = UniformBSplineBasis<double, 3>;
+        BOOST_REQUIRE_THROW(Basis{std::vector<double>({0.0, 1.0, 2.0, 3.0})}, BSplineException);
+        BOOST_REQUIRE_THROW(Basis{std::vector<double>({0.0, 1.0, 3.0, 2.0, 4.0})}, BSplineException);
+        BOOST_REQUIRE_THROW(Basis{std::vector<double>({0.0, 1.0, 2.0, 3.5, 4.0, 5.0})}, BSplineException);
+        BOOST_REQUIRE_THROW(Basis{std::vector<double>({0.0, 1.0, 2.0, 2.0, 3.0, 4.0})}, BSplineException);
+
+        const Basis basis(uniformKnots(1));
+        BOOST_REQUIRE_THROW(basis.at(basis.size()), BSplineException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
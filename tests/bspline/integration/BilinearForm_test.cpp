@@ -0,0 +1,263 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#include <bspline/BSplineBasis.h>
+#include <bspline/BSplineGenerator.h>
+#include <bspline/ParallelEvaluator.h>
+#include <bspline/UniformBSplineBasis.h>
+#include <bspline/integration/BilinearForm.h>
+#include <bspline/operators/CompoundOperators.h>
+#include <bspline/operators/Derivative.h>
+#include <bspline/operators/Position.h>
+#include <bspline/testData.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <functional>
+
+using namespace bspline;
+using namespace bspline::operators;
+
+/*!
+ * Checks that the matrix assembled by a bilinear form coincides with the
+ * values returned by BilinearForm::evaluate() for all pairs of splines, and
+ * that exactly the pairs with overlapping supports are stored.
+ *
+ * @param form The bilinear form.
+ * @param splines The splines.
+ */
+template<typename Form, typename SplineCollection>
+static void testAssembly(const Form &form, const SplineCollection &splines) {
+    const auto matrix = form.assemble(splines);
+    const size_t n = splines.size();
+    BOOST_REQUIRE(matrix.rows == n);
+    BOOST_REQUIRE(matrix.cols == n);
+    BOOST_REQUIRE(matrix.rowOffsets.size() == n + 1);
+
+    size_t overlapping = 0;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            const auto intersection = splines[i].getSupport().calcIntersection(splines[j].getSupport());
+            if (intersection.containsIntervals()) overlapping++;
+            BOOST_TEST(matrix.at(i, j) == form.evaluate(splines[i], splines[j]));
+        }
+    }
+    BOOST_TEST(matrix.nonZeros() == overlapping);
+}
+
+BOOST_AUTO_TEST_SUITE(BilinearFormTestSuite)
+
+/*!
+ * Passes if the assembled matrices coincide with the pairwise evaluation for
+ * symmetric and non-symmetric forms, splines and views.
+ */
+BOOST_AUTO_TEST_CASE(AssembleMatchesEvaluate) {
+        const std::vector<double> knots = clampedKnots(3, true);
+
+        const auto splines = generateBSplines<3>(knots);
+        const BSplineBasis basis(splines);
+        const auto splines7 = generateBSplines<7>(knots);
+
+        const integration::ScalarProduct scalarProduct;
+        const integration::BilinearForm hamiltonian{0.5 * (-Dx<2>{} + X<2>{})};
+        const integration::BilinearForm nonSymmetric{X<1>{}, Dx<1>{}};
+
+        testAssembly(scalarProduct, splines);
+        testAssembly(scalarProduct, basis);
+        testAssembly(hamiltonian, splines);
+        testAssembly(hamiltonian, splines7);
+        testAssembly(nonSymmetric, splines);
+        testAssembly(nonSymmetric, basis);
+}
+
+/*!
+ * Checks whether two sparse matrices are identical.
+ *
+ * @param a The first matrix.
+ * @param b The second matrix.
+ * @returns True if the dimensions, the sparsity patterns and all values
+ * coincide.
+ */
+template<typename T>
+static bool identical(const SparseMatrix<T> &a, const SparseMatrix<T> &b) {
+    return a.rows == b.rows && a.cols == b.cols && a.rowOffsets == b.rowOffsets &&
+           a.columnIndices == b.columnIndices && a.values == b.values;
+}
+
+/*!
+ * Passes if the matrices assembled in parallel are identical to the serially
+ * assembled ones, independent of the number of threads, the number of chunks
+ * and the execution order of the chunks.
+ */
+BOOST_AUTO_TEST_CASE(ParallelAssembly) {
+        std::vector<double> knots(4, 0.0);
+        for (size_t i = 1; i < 300; i++) {
+                knots.push_back(0.05 * static_cast<double>(i) + 1.0e-3 * static_cast<double>(i * i % 7));
+        }
+        knots.insert(knots.end(), 3, knots.back());
+        const auto splines = generateBSplines<5>(knots);
+
+        const integration::BilinearForm hamiltonian{0.5 * (-Dx<2>{} + X<2>{})};
+        const integration::ScalarProduct scalarProduct;
+        const auto expectedHamiltonian = hamiltonian.assemble(splines);
+        const auto expectedOverlap = scalarProduct.assemble(splines);
+
+        for (size_t nThreads: {1, 3}) {
+                ParallelEvaluator evaluator(nThreads);
+                BOOST_TEST(identical(hamiltonian.assemble(splines, evaluator), expectedHamiltonian));
+                BOOST_TEST(identical(scalarProduct.assemble(splines, evaluator), expectedOverlap));
+        }
+
+        // Chunks executed in reverse order.
+        const auto reversed = hamiltonian.assemble(
+                splines, 37, [](size_t nTasks, const std::function<void(size_t)> &task) {
+                        for (size_t c = nTasks; c > 0; c--) task(c - 1);
+                });
+        BOOST_TEST(identical(reversed, expectedHamiltonian));
+}
+
+/*!
+ * Passes if evaluations and matrices computed from pre-transformed splines are
+ * identical to those computed from the splines themselves.
+ */
+BOOST_AUTO_TEST_CASE(TransformedSplines) {
+        const std::vector<double> knots = clampedKnots(3, true);
+        const auto splines = generateBSplines<3>(knots);
+        const BSplineBasis basis(splines);
+        const std::vector<Spline<double, 3>> others{splines.front() + splines.back(), 2.0 * splines[5]};
+
+        const integration::BilinearForm hamiltonian{
+                X<2>{} * (-0.5 * Dx<2>{} - X<1>{} * Dx<1>{}) + 3.0 * X<1>{}};
+        const integration::BilinearForm nonSymmetric{X<1>{}, Dx<1>{}};
+
+        const auto transformed = hamiltonian.transform(splines);
+        const auto transformedBasis = nonSymmetric.transform(basis);
+        const auto transformedOthers = hamiltonian.transform(others);
+        BOOST_TEST(transformed.size() == splines.size());
+        BOOST_TEST((transformed.getGrid() == splines.front().getSupport().getGrid()));
+
+        for (size_t i = 0; i < splines.size(); i++) {
+                for (size_t j = 0; j < splines.size(); j++) {
+                        BOOST_TEST(hamiltonian.evaluate(transformed, i, j) ==
+                                   hamiltonian.evaluate(splines[i], splines[j]));
+                        BOOST_TEST(nonSymmetric.evaluate(transformedBasis, i, j) ==
+                                   nonSymmetric.evaluate(basis[i], basis[j]));
+                }
+                for (size_t j = 0; j < others.size(); j++) {
+                        BOOST_TEST(hamiltonian.evaluate(transformed, i, transformedOthers, j) ==
+                                   hamiltonian.evaluate(splines[i], others[j]));
+                        BOOST_TEST(hamiltonian.evaluate(transformedOthers, j, transformed, i) ==
+                                   hamiltonian.evaluate(others[j], splines[i]));
+                }
+        }
+
+        BOOST_TEST(identical(hamiltonian.assemble(transformed), hamiltonian.assemble(splines)));
+        BOOST_TEST(identical(nonSymmetric.assemble(transformedBasis), nonSymmetric.assemble(basis)));
+        const auto reversed = hamiltonian.assemble(
+                transformed, 37, [](size_t nTasks, const std::function<void(size_t)> &task) {
+                        for (size_t c = nTasks; c > 0; c--) task(c - 1);
+                });
+        BOOST_TEST(identical(reversed, hamiltonian.assemble(splines)));
+
+        using bspline::exceptions::BSplineException;
+        BOOST_REQUIRE_THROW(hamiltonian.evaluate(transformed, splines.size(), 0), BSplineException);
+        BOOST_REQUIRE_THROW(hamiltonian.evaluate(transformed, 0, transformedOthers, 2),
+                            BSplineException);
+        std::vector<double> otherKnots(knots);
+        otherKnots.back() += 1.0;
+        const auto otherGrid = hamiltonian.transform(generateBSplines<3>(otherKnots));
+        BOOST_REQUIRE_THROW(hamiltonian.evaluate(transformed, 0, otherGrid, 0), BSplineException);
+}
+
+/*!
+ * Passes if the translation-invariant operators are recognized.
+ */
+BOOST_AUTO_TEST_CASE(TranslationInvariance) {
+        BOOST_TEST(is_translation_invariant_v<IdentityOperator>);
+        BOOST_TEST(is_translation_invariant_v<Dx<3>>);
+        BOOST_TEST((is_translation_invariant_v<decltype(0.5 * (-Dx<2>{} + 3.0 * Dx<1>{} * Dx<1>{}))>));
+        const Dx<1> dx;
+        BOOST_TEST((is_translation_invariant_v<decltype(dx * dx - dx)>));
+        BOOST_TEST(!is_translation_invariant_v<X<0>>);
+        BOOST_TEST((!is_translation_invariant_v<decltype(0.5 * (-Dx<2>{} + X<2>{}))>));
+        BOOST_TEST((!is_translation_invariant_v<decltype(Dx<1>{} * X<1>{})>));
+}
+
+/*!
+ * Passes if the assembly over uniform bases yields matrices identical to those
+ * of the general assembly, also if the widths of the intervals differ by
+ * rounding errors.
+ */
+BOOST_AUTO_TEST_CASE(UniformStencilAssembly) {
+        const integration::ScalarProduct scalarProduct;
+        const integration::BilinearForm kinetic{-0.5 * Dx<2>{}};
+        const integration::BilinearForm nonSymmetric{Dx<1>{}, 2.0 * Dx<2>{} + Dx<1>{}};
+        const integration::BilinearForm hamiltonian{0.5 * (-Dx<2>{} + X<2>{})};
+
+        // Grid points exactly representable, boundary knots repeated or not.
+        std::vector<double> knots(4, -4.0);
+        for (size_t i = 1; i < 64; i++) {
+                knots.push_back(-4.0 + 0.125 * static_cast<double>(i));
+        }
+        knots.insert(knots.end(), 4, 4.0);
+        const auto basis = generateUniformBasis<3>(knots);
+        const auto splines = basis.toSplines();
+        const auto unclamped = generateUniformBasis<3>(std::vector<double>(knots.begin() + 3, knots.end() - 3));
+        const auto fewTranslates = generateUniformBasis<3>(std::vector<double>{0.0, 0.0, 0.0, 0.0, 0.5, 1.0,
+                                                                              1.0, 1.0, 1.0});
+        BOOST_TEST(fewTranslates.numberOfTranslates() == 0);
+
+        BOOST_TEST(identical(scalarProduct.assemble(basis), scalarProduct.assemble(splines)));
+        BOOST_TEST(identical(kinetic.assemble(basis), kinetic.assemble(splines)));
+        BOOST_TEST(identical(nonSymmetric.assemble(basis), nonSymmetric.assemble(splines)));
+        BOOST_TEST(identical(hamiltonian.assemble(basis), hamiltonian.assemble(splines)));
+        BOOST_TEST(identical(kinetic.assemble(unclamped), kinetic.assemble(unclamped.toSplines())));
+        BOOST_TEST(identical(nonSymmetric.assemble(fewTranslates),
+                             nonSymmetric.assemble(fewTranslates.toSplines())));
+
+        for (size_t nThreads: {1, 3}) {
+                ParallelEvaluator evaluator(nThreads);
+                BOOST_TEST(identical(nonSymmetric.assemble(basis, evaluator), nonSymmetric.assemble(splines)));
+        }
+        const auto reversed = nonSymmetric.assemble(
+                basis, 37, [](size_t nTasks, const std::function<void(size_t)> &task) {
+                        for (size_t c = nTasks; c > 0; c--) task(c - 1);
+                });
+        BOOST_TEST(identical(reversed, nonSymmetric.assemble(splines)));
+
+        // The widths of the intervals differ by rounding errors.
+        std::vector<double> roundedKnots(8, 0.0);
+        for (size_t i = 1; i < 50; i++) {
+                roundedKnots.push_back(0.1 * static_cast<double>(i));
+        }
+        roundedKnots.insert(roundedKnots.end(), 8, 5.0);
+        const auto roundedBasis = generateUniformBasis<7>(roundedKnots);
+        BOOST_TEST(roundedBasis.getGrid().halfWidth(0) != roundedBasis.getGrid().halfWidth(30));
+        BOOST_TEST(identical(kinetic.assemble(roundedBasis), kinetic.assemble(roundedBasis.toSplines())));
+        BOOST_TEST(identical(nonSymmetric.assemble(roundedBasis), nonSymmetric.assemble(roundedBasis.toSplines())));
+}
+
+/*!
+ * Passes if empty collections and splines defined on different grids are
+ * rejected.
+ */
+BOOST_AUTO_TEST_CASE(AssembleThrows) {
+        using bspline::exceptions::BSplineException;
+        const integration::ScalarProduct scalarProduct;
+        const std::vector<Spline<double, 3>> empty;
+        BOOST_REQUIRE_THROW(scalarProduct.assemble(empty), BSplineException);
+        BOOST_REQUIRE_THROW(scalarProduct.transform(empty), BSplineException);
+
+        auto differentGrids = generateBSplines<3>(DEFAULT_GRID_DATA);
+        std::vector<double> otherKnots(DEFAULT_GRID_DATA);
+        otherKnots.back() += 1.0;
+        differentGrids.push_back(generateBSplines<3>(otherKnots).front());
+        BOOST_REQUIRE_THROW(scalarProduct.assemble(differentGrids), BSplineException);
+        BOOST_REQUIRE_THROW(scalarProduct.transform(differentGrids), BSplineException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
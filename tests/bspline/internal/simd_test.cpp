@@ -0,0 +1,143 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#include <bspline/internal/simd.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <vector>
+
+using namespace bspline::internal;
+
+#ifdef BSPLINE_TEST_SIMD_REQUIRED
+static_assert(SimdRegister<double>::WIDTH > 0 && SimdRegister<float>::WIDTH > 0,
+              "BSPLINE_TEST_SIMD is set, but the vector registers are not enabled.");
+#endif
+
+/*!
+ * Returns the number of points processed per block by the kernels for the data
+ * type T, i.e. the register width or the block size of the portable
+ * implementation.
+ */
+template<typename T>
+static constexpr size_t blockWidth() {
+    return SimdRegister<T>::WIDTH > 0 ? SimdRegister<T>::WIDTH : 8;
+}
+
+/*!
+ * Returns n points spread over [-1, 1) in an irregular order.
+ *
+ * @param n The number of points.
+ * @returns The points.
+ */
+template<typename T>
+static std::vector<T> makePoints(size_t n) {
+    std::vector<T> xs(n);
+    for (size_t i = 0; i < n; i++) {
+        xs[i] = static_cast<T>(-1.0 + 2.0 * static_cast<double>(i * 37 % 101) / 101.0);
+    }
+    return xs;
+}
+
+/*!
+ * Checks that evaluateIntervalBatch() coincides bitwise with evaluateInterval()
+ * for all numbers of points up to three register widths, i.e. for fewer points
+ * than a register holds, for multiples of the width and for all remainders.
+ */
+template<typename T, size_t size>
+static void testBatch() {
+    std::array<T, size> coeffs;
+    for (size_t p = 0; p < size; p++) {
+        coeffs[p] = static_cast<T>(0.75 - 0.3 * static_cast<double>(p));
+    }
+    const T xm = static_cast<T>(0.125);
+
+    for (size_t n = 0; n <= 3 * blockWidth<T>() + 1; n++) {
+        // Offset by one element, such that the loads are unaligned.
+        const std::vector<T> xs = makePoints<T>(n + 1);
+        std::vector<T> out(n + 1, static_cast<T>(42));
+        evaluateIntervalBatch(xs.data() + 1, n, coeffs, xm, out.data());
+        std::vector<T> expected(n + 1, static_cast<T>(42));
+        for (size_t i = 0; i < n; i++) {
+            expected[i] = evaluateInterval(xs[i + 1], coeffs, xm);
+        }
+        BOOST_TEST(out == expected, boost::test_tools::per_element());
+    }
+}
+
+/*!
+ * Checks that evaluateIntervalsGather() coincides bitwise with the scalar
+ * evaluation for all numbers of points up to three register widths, both if all
+ * points of a block share an interval (broadcast) and if they do not (gather).
+ */
+template<typename T, size_t size>
+static void testGather() {
+    constexpr size_t N_INTERVALS = 5;
+    constexpr size_t STRIDE = 8;
+    std::vector<T> coefficients(size * STRIDE);
+    for (size_t k = 0; k < coefficients.size(); k++) {
+        coefficients[k] = static_cast<T>(0.5 - 0.01 * static_cast<double>(k * 13 % 29));
+    }
+    std::vector<T> midpoints(N_INTERVALS);
+    for (size_t k = 0; k < N_INTERVALS; k++) {
+        midpoints[k] = static_cast<T>(-0.8 + 0.4 * static_cast<double>(k));
+    }
+
+    for (bool sameInterval: {true, false}) {
+        for (size_t n = 0; n <= 3 * blockWidth<T>() + 1; n++) {
+            const std::vector<T> xs = makePoints<T>(n);
+            std::vector<size_t> intervals(n);
+            for (size_t i = 0; i < n; i++) {
+                intervals[i] = sameInterval ? 3 : i * 7 % N_INTERVALS;
+            }
+            std::vector<T> out(n + 1, static_cast<T>(42));
+            evaluateIntervalsGather<size>(xs.data(), intervals.data(), n, coefficients.data(),
+                                          STRIDE, midpoints.data(), out.data());
+            std::vector<T> expected(n + 1, static_cast<T>(42));
+            for (size_t i = 0; i < n; i++) {
+                const T dx = xs[i] - midpoints[intervals[i]];
+                expected[i] = coefficients[(size - 1) * STRIDE + intervals[i]];
+                for (size_t p = size - 1; p-- > 0;) {
+                    expected[i] = dx * expected[i] + coefficients[p * STRIDE + intervals[i]];
+                }
+            }
+            BOOST_TEST(out == expected, boost::test_tools::per_element());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(SimdTestSuite)
+
+/*!
+ * Passes if the batch kernel reproduces the scalar Horner scheme at the
+ * remainder edges of the vectorized loop.
+ */
+BOOST_AUTO_TEST_CASE(BatchRemainders) {
+        BOOST_TEST_MESSAGE("Register width (double, float): " << SimdRegister<double>::WIDTH << ", "
+                                                              << SimdRegister<float>::WIDTH);
+        testBatch<double, 1>();
+        testBatch<double, 4>();
+        testBatch<double, 8>();
+        testBatch<float, 4>();
+        testBatch<float, 8>();
+        testBatch<long double, 4>();
+}
+
+/*!
+ * Passes if the structure-of-arrays kernel reproduces the scalar Horner scheme
+ * at the remainder edges of the vectorized loop.
+ */
+BOOST_AUTO_TEST_CASE(GatherRemainders) {
+        testGather<double, 1>();
+        testGather<double, 4>();
+        testGather<double, 8>();
+        testGather<float, 4>();
+        testGather<float, 8>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
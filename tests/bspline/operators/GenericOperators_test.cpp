@@ -38,6 +38,13 @@ static void testSplineMultiplication() {
         const auto transformedSpline = op * spline;
         const bool splinesEqual = (spline == transformedSpline);
         BOOST_TEST(splinesEqual);
+
+        // A temporary spline is transformed in-place.
+        auto temporary = spline;
+        const auto *data = temporary.getCoefficients().data();
+        const auto transformedTemporary = op * std::move(temporary);
+        BOOST_TEST((transformedTemporary == spline));
+        BOOST_TEST(transformedTemporary.getCoefficients().data() == data);
     }
 }
 
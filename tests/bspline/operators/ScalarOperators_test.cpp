@@ -52,6 +52,10 @@ static void testSplineMultiplication(T tol) {
         BOOST_CHECK_SMALL(diffNorm(op1 * spline, multiplicator * spline), tol);
         BOOST_CHECK_SMALL(
                 diffNorm(op2 * spline, Dx<1>{} * (multiplicator * spline)), tol);
+
+        // Temporaries yield the same splines as const operands.
+        BOOST_TEST((op1 * Spline(spline) == op1 * spline));
+        BOOST_TEST((op2 * Spline(spline) == op2 * spline));
     }
 }
 
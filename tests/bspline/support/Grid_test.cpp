@@ -6,20 +6,19 @@
  */
 
 #include <bspline/support/Support.h>
+#include <bspline/testData.h>
 
 #include <boost/test/tools/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <memory>
 #include <type_traits>
 
 static_assert(!std::is_move_constructible_v<bspline::support::Grid<double>> &&
               !std::is_move_assignable_v<bspline::support::Grid<double>>,
               "Grid is movable.");
 
-extern const std::vector<double> DEFAULT_GRID_DATA;
-const std::vector<double> DEFAULT_GRID_DATA{
-        -7.0l, -6.85l, -6.55l, -6.3l, -6.0l, -5.75l, -5.53l, -5.2l, -4.75l, -4.5l,
-        -3.0l, -2.5l, -1.5l, -1.0l, 0.0l, 0.5l, 1.5l, 2.5l, 3.5l, 4.0l,
-        4.35l, 4.55l, 4.95l, 5.4l, 5.7l, 6.1l, 6.35l, 6.5l, 6.85l, 7.0l};
+const std::vector<double> DEFAULT_GRID_DATA = defaultKnots<double>();
 
 BOOST_AUTO_TEST_SUITE(GridTestSuite)
 
@@ -79,6 +78,31 @@ BOOST_AUTO_TEST_CASE(ConstructNotSteadilyIncreasingThrows) {
             auto grid2 = grid1;
             BOOST_TEST((grid1.getData() != nullptr && grid2.getData() != nullptr));
             BOOST_TEST(grid1 == grid2);
+            BOOST_TEST(grid1.getData() == grid2.getData());
+
+            // The grid points and the lookup cache share a single control block.
+            static_assert(sizeof(Grid) == sizeof(std::shared_ptr<const std::vector<double>>));
+}
+
+/*!
+ * Passes if a grid constructed from a shared pointer shares the grid points
+ * instead of copying them.
+ */
+BOOST_AUTO_TEST_CASE(SharedGridData) {
+            using Grid = bspline::support::Grid<double>;
+            using BSplineException = bspline::exceptions::BSplineException;
+
+            const auto data = std::make_shared<const std::vector<double>>(DEFAULT_GRID_DATA);
+            const Grid grid1(data);
+            const Grid grid2 = grid1;
+            BOOST_TEST(grid1.getData() == data);
+            BOOST_TEST(grid2.getData() == data);
+            BOOST_TEST(&grid1[0] == data->data());
+            BOOST_TEST((grid1 == Grid(DEFAULT_GRID_DATA)));
+            BOOST_TEST(grid1.findInterval(0.25).value() == 14);
+
+            BOOST_REQUIRE_THROW(Grid(std::shared_ptr<const std::vector<double>>()),
+                                BSplineException);
 }
 
 /*!
@@ -183,4 +207,79 @@ BOOST_AUTO_TEST_CASE(FindElement) {
             BOOST_REQUIRE_THROW(grid.findElement(tooSmall), BSplineException);
 }
 
+/*!
+ * Checks that findInterval() agrees with a binary search for points on and
+ * between the grid points as well as outside of the grid.
+ *
+ * @param grid The grid to check.
+ */
+static void checkFindInterval(const bspline::support::Grid<double> &grid) {
+        std::vector<double> points(grid.begin(), grid.end());
+        for (size_t i = 0; i + 1 < grid.size(); i++) {
+                for (int j = 1; j < 10; j++) {
+                        points.push_back(grid[i] + (grid[i + 1] - grid[i]) * j / 10.0);
+                }
+        }
+
+        for (const double x: points) {
+                const auto it = std::lower_bound(grid.begin(), grid.end(), x);
+                const size_t expected =
+                        std::max<size_t>(std::distance(grid.begin(), it), 1) - 1;
+                BOOST_TEST(grid.findInterval(x).value() == expected);
+        }
+
+        BOOST_TEST(!grid.findInterval(grid.front() - 1.0e-4));
+        BOOST_TEST(!grid.findInterval(grid.back() + 1.0e-4));
+}
+
+/*!
+ * Passes if the method findInterval() returns the same intervals as a binary
+ * search, both on uniform and non-uniform grids.
+ */
+BOOST_AUTO_TEST_CASE(FindInterval) {
+            using Grid = bspline::support::Grid<double>;
+
+            const Grid nonUniformGrid(DEFAULT_GRID_DATA);
+            BOOST_TEST(!nonUniformGrid.isUniform());
+            checkFindInterval(nonUniformGrid);
+
+            std::vector<double> uniformGridData;
+            for (int i = -100; i <= 100; i++) {
+                    uniformGridData.push_back(static_cast<double>(i) / 10);
+            }
+            const Grid uniformGrid(uniformGridData);
+            BOOST_TEST(uniformGrid.isUniform());
+            checkFindInterval(uniformGrid);
+
+            // Large geometric grid, searched via the Eytzinger layout.
+            std::vector<double> geometricGridData;
+            for (int i = 0; i <= 2000; i++) {
+                    geometricGridData.push_back(0.01 * std::pow(1.005, i));
+            }
+            const Grid geometricGrid(geometricGridData);
+            BOOST_TEST(!geometricGrid.isUniform());
+            checkFindInterval(geometricGrid);
+
+            // The copy shares the lookup data.
+            const Grid uniformGridCopy = uniformGrid;
+            BOOST_TEST(uniformGridCopy.isUniform());
+            checkFindInterval(uniformGridCopy);
+}
+
+/*!
+ * Passes if the cached midpoints and half widths of the intervals coincide
+ * with the ones computed from the grid points and are shared between copies.
+ */
+BOOST_AUTO_TEST_CASE(IntervalMidpointsAndHalfWidths) {
+            using Grid = bspline::support::Grid<double>;
+
+            const Grid grid(DEFAULT_GRID_DATA);
+            const Grid copy = grid;
+            for (size_t i = 0; i + 1 < grid.size(); i++) {
+                    BOOST_TEST(grid.midpoint(i) == (grid[i + 1] + grid[i]) / 2.0);
+                    BOOST_TEST(grid.halfWidth(i) == (grid[i + 1] - grid[i]) / 2.0);
+                    BOOST_TEST(&copy.midpoint(i) == &grid.midpoint(i));
+            }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,7 @@
  */
 
 #include <bspline/support/Support.h>
+#include <bspline/testData.h>
 
 #include <boost/test/tools/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
@@ -16,8 +17,6 @@ static_assert(
         std::is_nothrow_move_assignable_v<bspline::support::Support<double>>,
         "Support is not nothrow movable.");
 
-extern const std::vector<double> DEFAULT_GRID_DATA;
-
 template<typename T>
 static void testSupport() {
     using Support = bspline::support::Support<T>;
@@ -0,0 +1,115 @@
+/*
+ * ########################################################################
+ * The contents of this file is free and unencumbered software released into the
+ * public domain. For more information, please refer to <http://unlicense.org/>
+ * ########################################################################
+ */
+
+#ifndef BSPLINE_TESTS_TESTDATA_H
+#define BSPLINE_TESTS_TESTDATA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/*!
+ * The knots used by most tests, in double precision. Defined in
+ * support/Grid_test.cpp as defaultKnots<double>().
+ */
+extern const std::vector<double> DEFAULT_GRID_DATA;
+
+/*!
+ * Returns the knots used by most tests. They are given as long double literals,
+ * such that no precision is lost for T = long double.
+ *
+ * @tparam T The datatype of the knots.
+ * @returns The 30 non-equidistant knots on [-7, 7].
+ */
+template<typename T>
+std::vector<T> defaultKnots() {
+    return std::vector<T>{
+            -7.0l, -6.85l, -6.55l, -6.3l, -6.0l, -5.75l, -5.53l, -5.2l, -4.75l, -4.5l,
+            -3.0l, -2.5l, -1.5l, -1.0l, 0.0l, 0.5l, 1.5l, 2.5l, 3.5l, 4.0l,
+            4.35l, 4.55l, 4.95l, 5.4l, 5.7l, 6.1l, 6.35l, 6.5l, 6.85l, 7.0l};
+}
+
+/*!
+ * Returns DEFAULT_GRID_DATA with the first knot, and optionally the last knot,
+ * repeated, such that the BSplines of the corresponding order are not
+ * continuous at the boundaries.
+ *
+ * @param nRepeats The number of additional copies of the boundary knots.
+ * @param clampBack Whether the last knot is repeated as well.
+ * @returns The knots.
+ */
+inline std::vector<double> clampedKnots(size_t nRepeats, bool clampBack) {
+    std::vector<double> knots(nRepeats, DEFAULT_GRID_DATA.front());
+    knots.insert(knots.end(), DEFAULT_GRID_DATA.begin(), DEFAULT_GRID_DATA.end());
+    if (clampBack) {
+        knots.insert(knots.end(), nRepeats, DEFAULT_GRID_DATA.back());
+    }
+    return knots;
+}
+
+/*!
+ * Returns the points at which splines on DEFAULT_GRID_DATA are evaluated by the
+ * tests: the knots and equidistant points on [-8, 8], i.e. points on the grid
+ * points, between them and outside of the grid.
+ *
+ * @param step The distance between the equidistant points.
+ * @returns The points in increasing order.
+ */
+inline std::vector<double> testPoints(double step) {
+    std::vector<double> xs(DEFAULT_GRID_DATA);
+    for (double x = -8.0; x <= 8.0; x += step) {
+        xs.push_back(x);
+    }
+    std::sort(xs.begin(), xs.end());
+    return xs;
+}
+
+/*!
+ * Returns the points in an order jumping back and forth across the grid, such
+ * that consecutive points hardly ever share an interval.
+ *
+ * @param xs The points.
+ * @returns The permuted points.
+ */
+inline std::vector<double> jumpingOrder(const std::vector<double> &xs) {
+    std::vector<double> jumping;
+    jumping.reserve(xs.size());
+    for (size_t i = 0; i < xs.size(); i++) {
+        jumping.push_back(xs[(i * 7919) % xs.size()]);
+    }
+    return jumping;
+}
+
+/*!
+ * Memory resource counting the allocations passed on to the upstream resource.
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+
+private:
+    std::pmr::memory_resource *_upstream;
+
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        return _upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        _upstream->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    explicit CountingResource(std::pmr::memory_resource *upstream) : _upstream(upstream) {}
+};
+
+#endif// BSPLINE_TESTS_TESTDATA_H